@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../include/graph/graph.hpp"
+#include "../include/generators/generators.hpp"
+#include "../include/io/csv.hpp"
+#include "../include/io/graph_io.hpp"
+#include "bench_util.hpp"
+#include "perf_counters.hpp"
+
+using namespace graph_coloring;
+
+// Benchmark suite: every coloring algorithm over a matrix of generated and file graphs
+
+struct BenchConfig {
+    int warmup = 1;
+    int repetitions = 5;
+    int exactMaxVertices = 16;   // Exact search explodes beyond this
+    std::vector<ColoringAlgorithm> algorithms = allColoringAlgorithms();
+    std::vector<std::string> files;
+    std::string format = "json";
+    std::string outputPath;
+    std::string filter;          // Only run graphs whose name contains this
+    bool perf = false;           // Collect hardware counters around each timed run
+};
+
+struct BenchGraph {
+    std::string name;
+    std::function<Graph()> build;
+};
+
+struct BenchResult {
+    std::string graph;
+    std::string algorithm;
+    int vertices = 0;
+    int edges = 0;
+    int colors = 0;
+    bool valid = false;
+    std::vector<double> samplesMs;
+    double minMs = 0.0;
+    double medianMs = 0.0;
+    double p95Ms = 0.0;
+    double meanMs = 0.0;
+    bool hasPerf = false;
+    PerfCounters::Sample perf;   // Mean per timed run
+};
+
+std::vector<BenchGraph> defaultGraphs() {
+    // Fixed seeds keep the matrix identical between versions
+    return {
+        {"petersen", []() { return GraphGenerator::petersen(); }},
+        {"random_n14_p50", []() { return GraphGenerator::random(14, 0.5, 7); }},
+        {"complete_60", []() { return GraphGenerator::complete(60); }},
+        {"cycle_1000", []() { return GraphGenerator::cycle(1000); }},
+        {"grid_30x30", []() { return GraphGenerator::grid(30, 30); }},
+        {"random_n200_p05", []() { return GraphGenerator::random(200, 0.05, 1); }},
+        {"random_n1000_p01", []() { return GraphGenerator::random(1000, 0.01, 2); }},
+        {"geometric_n1000_r05", []() { return GraphGenerator::randomGeometric(1000, 0.05, 3); }},
+    };
+}
+
+// Nearest-rank percentile of an already sorted sample
+double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+BenchResult runCase(const std::string& name, Graph& graph, ColoringAlgorithm algorithm, const BenchConfig& config,
+                    PerfCounters* counters) {
+    BenchResult result;
+    result.graph = name;
+    result.algorithm = coloringAlgorithmName(algorithm);
+    result.vertices = graph.getVertexCount();
+    result.edges = graph.getEdgeCount();
+    
+    for (int i = 0; i < config.warmup; i++) {
+        graph.colorGraph(algorithm);
+    }
+    
+    for (int i = 0; i < config.repetitions; i++) {
+        if (counters) {
+            counters->start();
+        }
+        auto start = std::chrono::steady_clock::now();
+        graph.colorGraph(algorithm);
+        std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+        if (counters) {
+            result.perf += counters->stop();
+        }
+        result.samplesMs.push_back(duration.count());
+    }
+    
+    if (counters) {
+        result.hasPerf = true;
+        for (int i = 0; i < PerfCounters::COUNTER_COUNT; i++) {
+            result.perf.values[i] /= config.repetitions;
+        }
+    }
+    
+    result.colors = graph.getNumberOfColors();
+    result.valid = graph.isValidColoring();
+    
+    std::vector<double> sorted = result.samplesMs;
+    std::sort(sorted.begin(), sorted.end());
+    result.minMs = sorted.empty() ? 0.0 : sorted.front();
+    result.medianMs = percentile(sorted, 0.5);
+    result.p95Ms = percentile(sorted, 0.95);
+    double total = 0.0;
+    for (double sample : sorted) {
+        total += sample;
+    }
+    result.meanMs = sorted.empty() ? 0.0 : total / sorted.size();
+    
+    return result;
+}
+
+// Derived metrics used to compare memory layouts and orderings
+double ipc(const PerfCounters::Sample& perf) {
+    return perf.ratio(PerfCounters::Instructions, PerfCounters::Cycles);
+}
+
+double cacheMissRate(const PerfCounters::Sample& perf) {
+    return perf.ratio(PerfCounters::CacheMisses, PerfCounters::CacheReferences);
+}
+
+double branchMissRate(const PerfCounters::Sample& perf) {
+    return perf.ratio(PerfCounters::BranchMisses, PerfCounters::Branches);
+}
+
+void writePerfJson(std::ostream& out, const PerfCounters::Sample& perf) {
+    out << ", \"perf\": {";
+    for (int i = 0; i < PerfCounters::COUNTER_COUNT; i++) {
+        out << "\"" << PerfCounters::counterName(static_cast<PerfCounters::Counter>(i)) << "\": ";
+        if (perf.available[i]) {
+            out << static_cast<long long>(perf.values[i]);
+        } else {
+            out << "null";
+        }
+        out << ", ";
+    }
+    out << "\"ipc\": " << ipc(perf) << ", \"cache_miss_rate\": " << cacheMissRate(perf)
+        << ", \"branch_miss_rate\": " << branchMissRate(perf) << "}";
+}
+
+void writeJson(std::ostream& out, const BenchConfig& config, const std::vector<BenchResult>& results) {
+    out << "{\n";
+    out << "  \"warmup\": " << config.warmup << ",\n";
+    out << "  \"repetitions\": " << config.repetitions << ",\n";
+    out << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"graph\": \"" << jsonEscape(r.graph) << "\", \"algorithm\": \"" << r.algorithm << "\""
+            << ", \"vertices\": " << r.vertices << ", \"edges\": " << r.edges
+            << ", \"colors\": " << r.colors << ", \"valid\": " << (r.valid ? "true" : "false")
+            << ", \"min_ms\": " << r.minMs << ", \"median_ms\": " << r.medianMs
+            << ", \"p95_ms\": " << r.p95Ms << ", \"mean_ms\": " << r.meanMs;
+        if (r.hasPerf) {
+            writePerfJson(out, r.perf);
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void writeCsv(std::ostream& out, const BenchConfig& config, const std::vector<BenchResult>& results) {
+    out << "graph,algorithm,vertices,edges,colors,valid,min_ms,median_ms,p95_ms,mean_ms";
+    if (config.perf) {
+        out << ",cycles,instructions,ipc,cache_miss_rate,branch_miss_rate,llc_load_misses";
+    }
+    out << '\n';
+    
+    for (const auto& r : results) {
+        out << csvField(r.graph) << ',' << r.algorithm << ',' << r.vertices << ',' << r.edges << ','
+            << r.colors << ',' << (r.valid ? "yes" : "no") << ',' << r.minMs << ','
+            << r.medianMs << ',' << r.p95Ms << ',' << r.meanMs;
+        if (config.perf) {
+            // Unavailable counters are written as -1
+            auto value = [&r](PerfCounters::Counter counter) {
+                return r.perf.available[counter] ? static_cast<long long>(r.perf.values[counter]) : -1LL;
+            };
+            out << ',' << value(PerfCounters::Cycles) << ',' << value(PerfCounters::Instructions) << ','
+                << ipc(r.perf) << ',' << cacheMissRate(r.perf) << ',' << branchMissRate(r.perf) << ','
+                << value(PerfCounters::LlcLoadMisses);
+        }
+        out << '\n';
+    }
+}
+
+void printUsage() {
+    std::cout << "Usage: bench [options] [graph files...]" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --algorithms=<a,b>     Algorithms to run (default: all but portfolio)" << std::endl;
+    std::cout << "  --warmup=<n>           Untimed runs before measuring (default: 1)" << std::endl;
+    std::cout << "  --repetitions=<n>      Timed runs per graph/algorithm (default: 5)" << std::endl;
+    std::cout << "  --exact-max-vertices=<n> Skip exact coloring above this size (default: 16)" << std::endl;
+    std::cout << "  --filter=<text>        Only run graphs whose name contains <text>" << std::endl;
+    std::cout << "  --perf                 Collect hardware performance counters (Linux, single-threaded algorithms)" << std::endl;
+    std::cout << "  --format=<json|csv>    Output format (default: json)" << std::endl;
+    std::cout << "  --output=<file>        Write results to a file instead of stdout" << std::endl;
+    std::cout << "  --help                 Show this help message" << std::endl;
+}
+
+bool parseArguments(int argc, char** argv, BenchConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        
+        if (arg == "--help") {
+            printUsage();
+            std::exit(0);
+        } else if (arg.find("--algorithms=") == 0) {
+            if (!parseAlgorithmList(arg.substr(13), config.algorithms)) {
+                std::cerr << "Invalid algorithm list: " << arg.substr(13) << std::endl;
+                return false;
+            }
+        } else if (arg.find("--warmup=") == 0) {
+            config.warmup = std::atoi(arg.substr(9).c_str());
+        } else if (arg.find("--repetitions=") == 0) {
+            config.repetitions = std::max(1, std::atoi(arg.substr(14).c_str()));
+        } else if (arg.find("--exact-max-vertices=") == 0) {
+            config.exactMaxVertices = std::atoi(arg.substr(21).c_str());
+        } else if (arg.find("--filter=") == 0) {
+            config.filter = arg.substr(9);
+        } else if (arg == "--perf") {
+            config.perf = true;
+        } else if (arg.find("--format=") == 0) {
+            config.format = arg.substr(9);
+            if (config.format != "json" && config.format != "csv") {
+                std::cerr << "Invalid format: " << config.format << std::endl;
+                return false;
+            }
+        } else if (arg.find("--output=") == 0) {
+            config.outputPath = arg.substr(9);
+        } else if (arg.find("--") != 0) {
+            config.files.push_back(arg);
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        printUsage();
+        return 1;
+    }
+    
+    std::vector<BenchGraph> graphs = defaultGraphs();
+    for (const auto& file : config.files) {
+        graphs.push_back({file, [file]() { return GraphLoader::loadFromFile(file); }});
+    }
+    
+    // Counters are opened once and reused for every run on this thread
+    std::unique_ptr<PerfCounters> counters;
+    if (config.perf) {
+        counters = std::make_unique<PerfCounters>();
+        if (!counters->isAvailable()) {
+            std::cerr << "Hardware counters unavailable (check perf_event_paranoid); reporting timings only" << std::endl;
+        }
+    }
+    
+    std::vector<BenchResult> results;
+    for (const auto& benchGraph : graphs) {
+        if (!config.filter.empty() && benchGraph.name.find(config.filter) == std::string::npos) {
+            continue;
+        }
+        
+        Graph graph;
+        try {
+            graph = benchGraph.build();
+        } catch (const std::exception& e) {
+            std::cerr << "Skipping " << benchGraph.name << ": " << e.what() << std::endl;
+            continue;
+        }
+        graph.setVerbose(false);
+        
+        for (ColoringAlgorithm algorithm : config.algorithms) {
+            if (algorithm == ColoringAlgorithm::Exact && graph.getVertexCount() > config.exactMaxVertices) {
+                continue;
+            }
+            // Counters only see the calling thread, so they would miss most
+            // of the work of an algorithm that runs on the thread pool
+            PerfCounters* caseCounters = counters.get();
+            if (caseCounters && algorithm == ColoringAlgorithm::Portfolio) {
+                std::cerr << "Skipping hardware counters for " << coloringAlgorithmName(algorithm)
+                          << ": it runs on several threads" << std::endl;
+                caseCounters = nullptr;
+            }
+            BenchResult result = runCase(benchGraph.name, graph, algorithm, config, caseCounters);
+            std::cerr << result.graph << " / " << result.algorithm << ": median " << result.medianMs
+                      << " ms, p95 " << result.p95Ms << " ms, " << result.colors << " colors";
+            if (result.hasPerf && ipc(result.perf) >= 0.0) {
+                std::cerr << ", IPC " << ipc(result.perf);
+            }
+            std::cerr << std::endl;
+            results.push_back(result);
+        }
+    }
+    
+    std::ofstream file;
+    if (!config.outputPath.empty()) {
+        file.open(config.outputPath);
+        if (!file) {
+            std::cerr << "Cannot write results: " << config.outputPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = config.outputPath.empty() ? std::cout : file;
+    
+    if (config.format == "csv") {
+        writeCsv(out, config, results);
+    } else {
+        writeJson(out, config, results);
+    }
+    
+    return 0;
+}
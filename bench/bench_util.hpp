@@ -0,0 +1,38 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/graph/graph.hpp"
+
+namespace graph_coloring {
+
+// Helpers shared by the benchmark executables
+
+inline std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+// Parse a comma separated algorithm list ("greedy,sf"); false on unknown names
+inline bool parseAlgorithmList(const std::string& list, std::vector<ColoringAlgorithm>& algorithms) {
+    algorithms.clear();
+    std::stringstream names(list);
+    std::string name;
+    while (std::getline(names, name, ',')) {
+        ColoringAlgorithm algorithm;
+        if (!parseColoringAlgorithm(name, algorithm)) {
+            return false;
+        }
+        algorithms.push_back(algorithm);
+    }
+    return !algorithms.empty();
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/graph/graph.hpp"
+#include "../include/coloring/solver.hpp"
+#include "../include/io/csv.hpp"
+#include "../include/io/graph_io.hpp"
+#include "bench_util.hpp"
+
+using namespace graph_coloring;
+
+// Runs coloring algorithms over a manifest of DIMACS instances with known bounds
+// and reports how far each algorithm is from the best known coloring.
+
+struct Instance {
+    std::string name;
+    std::string path;
+    int lowerBound = -1; // -1 = unknown
+    int bestKnown = -1;
+};
+
+struct HarnessConfig {
+    std::string manifestPath;
+    std::vector<ColoringAlgorithm> algorithms = allColoringAlgorithms();
+    double timeLimitSeconds = 60.0;
+    std::string format = "csv";
+    std::string outputPath;
+    std::string filter;
+};
+
+struct RunReport {
+    std::string instance;
+    std::string algorithm;
+    std::string status;     // ok, optimal, timeout (best coloring so far), invalid, error
+    std::string error;
+    int vertices = 0;
+    int edges = 0;
+    int colors = -1;
+    bool valid = false;
+    int lowerBound = -1;
+    int bestKnown = -1;
+    double timeMs = 0.0;
+    double timeToBestMs = -1.0; // -1 = best known not reached
+    double timeToFinalMs = -1.0; // When the returned color count was first reached
+};
+
+std::vector<Instance> loadManifest(const std::string& path) {
+    std::ifstream input(path);
+    if (!input) {
+        throw std::runtime_error("Cannot open manifest: " + path);
+    }
+    
+    // Instance paths are relative to the manifest's directory
+    std::filesystem::path baseDir = std::filesystem::path(path).parent_path();
+    std::vector<Instance> instances;
+    std::string line;
+    int lineNumber = 0;
+    
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        
+        std::istringstream tokens(line);
+        Instance instance;
+        std::string lower;
+        std::string best;
+        if (!(tokens >> instance.name >> instance.path >> lower >> best)) {
+            throw std::runtime_error("Malformed manifest line " + std::to_string(lineNumber));
+        }
+        
+        instance.lowerBound = lower == "-" ? -1 : std::atoi(lower.c_str());
+        instance.bestKnown = best == "-" ? -1 : std::atoi(best.c_str());
+        if (std::filesystem::path(instance.path).is_relative()) {
+            instance.path = (baseDir / instance.path).string();
+        }
+        instances.push_back(instance);
+    }
+    
+    return instances;
+}
+
+// Color the shared adjacency with the time limit as the solve budget; a run
+// that hits it reports the best coloring found so far as a timeout. Times to
+// a color count come from the solver's progress events, so anytime
+// algorithms are credited when they found a coloring, not when they stopped.
+RunReport runWithTimeLimit(const Instance& instance, const CsrGraph& csr, ColoringAlgorithm algorithm,
+                           double timeLimitSeconds) {
+    RunReport report;
+    report.instance = instance.name;
+    report.algorithm = coloringAlgorithmName(algorithm);
+    report.lowerBound = instance.lowerBound;
+    report.bestKnown = instance.bestKnown;
+    report.vertices = csr.getVertexCount();
+    report.edges = csr.getEdgeCount();
+    
+    // First time each color count was reached; the callback runs on solver
+    // threads but never concurrently
+    std::map<int, double> firstReachedMs;
+    SolveOptions options;
+    options.timeLimitSeconds = timeLimitSeconds;
+    options.progress = [&firstReachedMs](const SolveProgress& progress) {
+        if (progress.colors > 0) {
+            firstReachedMs.emplace(progress.colors, progress.elapsedMs);
+        }
+    };
+    
+    try {
+        auto start = std::chrono::steady_clock::now();
+        Coloring coloring = solveColoring(csr, algorithm, options);
+        std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+        report.timeMs = duration.count();
+        report.colors = coloring.getNumberOfColors();
+        report.valid = coloring.isValid();
+        
+        if (!report.valid) {
+            report.status = "invalid";
+        } else if (coloring.getStatus() == SolveStatus::TimeLimit) {
+            report.status = "timeout";
+        } else if (coloring.getStatus() == SolveStatus::Optimal) {
+            report.status = "optimal";
+        } else {
+            report.status = "ok";
+        }
+        if (report.valid) {
+            // Color counts only go down, so the first at or below a target is the earliest
+            for (const auto& reached : firstReachedMs) {
+                if (reached.first <= report.colors &&
+                    (report.timeToFinalMs < 0.0 || reached.second < report.timeToFinalMs)) {
+                    report.timeToFinalMs = reached.second;
+                }
+                if (instance.bestKnown >= 0 && reached.first <= instance.bestKnown &&
+                    (report.timeToBestMs < 0.0 || reached.second < report.timeToBestMs)) {
+                    report.timeToBestMs = reached.second;
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        report.status = "error";
+        report.error = e.what();
+    }
+    
+    return report;
+}
+
+// Colors above the best known bound; -1 when it cannot be computed
+int gap(const RunReport& report) {
+    if (!report.valid || report.bestKnown < 0) {
+        return -1;
+    }
+    return report.colors - report.bestKnown;
+}
+
+void writeCsv(std::ostream& out, const std::vector<RunReport>& reports) {
+    out << "instance,algorithm,status,vertices,edges,colors,lower_bound,best_known,gap,time_ms,time_to_best_ms,time_to_final_ms,error\n";
+    for (const auto& r : reports) {
+        out << csvField(r.instance) << ',' << r.algorithm << ',' << r.status << ',' << r.vertices << ','
+            << r.edges << ',' << r.colors << ',' << r.lowerBound << ',' << r.bestKnown << ','
+            << gap(r) << ',' << r.timeMs << ',' << r.timeToBestMs << ',' << r.timeToFinalMs << ',' << csvField(r.error) << '\n';
+    }
+}
+
+void writeJson(std::ostream& out, const HarnessConfig& config, const std::vector<RunReport>& reports) {
+    out << "{\n";
+    out << "  \"manifest\": \"" << jsonEscape(config.manifestPath) << "\",\n";
+    out << "  \"time_limit_s\": " << config.timeLimitSeconds << ",\n";
+    out << "  \"runs\": [";
+    for (size_t i = 0; i < reports.size(); i++) {
+        const RunReport& r = reports[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"instance\": \"" << jsonEscape(r.instance) << "\", \"algorithm\": \"" << r.algorithm
+            << "\", \"status\": \"" << r.status << "\", \"vertices\": " << r.vertices
+            << ", \"edges\": " << r.edges << ", \"colors\": " << r.colors
+            << ", \"lower_bound\": " << r.lowerBound << ", \"best_known\": " << r.bestKnown
+            << ", \"gap\": " << gap(r) << ", \"time_ms\": " << r.timeMs
+            << ", \"time_to_best_ms\": " << r.timeToBestMs
+            << ", \"time_to_final_ms\": " << r.timeToFinalMs
+            << ", \"error\": \"" << jsonEscape(r.error) << "\"}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// Per-algorithm quality summary on stderr
+void printSummary(const std::vector<RunReport>& reports) {
+    struct Totals {
+        int runs = 0;
+        int atBest = 0;
+        int timeouts = 0;
+        int gapSum = 0;
+        int gapCount = 0;
+    };
+    std::map<std::string, Totals> totals;
+    
+    for (const auto& r : reports) {
+        Totals& t = totals[r.algorithm];
+        t.runs++;
+        if (r.status == "timeout") {
+            t.timeouts++;
+        }
+        if (r.timeToBestMs >= 0.0) {
+            t.atBest++;
+        }
+        if (gap(r) >= 0) {
+            t.gapSum += gap(r);
+            t.gapCount++;
+        }
+    }
+    
+    std::cerr << std::left << std::setw(10) << "algorithm" << std::setw(8) << "runs"
+              << std::setw(10) << "at best" << std::setw(10) << "timeouts" << "mean gap" << std::endl;
+    for (const auto& entry : totals) {
+        const Totals& t = entry.second;
+        std::cerr << std::left << std::setw(10) << entry.first << std::setw(8) << t.runs
+                  << std::setw(10) << t.atBest << std::setw(10) << t.timeouts;
+        if (t.gapCount > 0) {
+            std::cerr << static_cast<double>(t.gapSum) / t.gapCount;
+        } else {
+            std::cerr << "-";
+        }
+        std::cerr << std::endl;
+    }
+}
+
+void printUsage() {
+    std::cout << "Usage: dimacs_harness [options] <manifest>" << std::endl;
+    std::cout << "Manifest lines: <name> <file> <lower bound|-> <best known|->" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --algorithms=<a,b>     Algorithms to run (default: all but portfolio)" << std::endl;
+    std::cout << "  --time-limit=<sec>     Per-run time limit in seconds (default: 60)" << std::endl;
+    std::cout << "  --filter=<text>        Only run instances whose name contains <text>" << std::endl;
+    std::cout << "  --format=<csv|json>    Output format (default: csv)" << std::endl;
+    std::cout << "  --output=<file>        Write results to a file instead of stdout" << std::endl;
+    std::cout << "  --help                 Show this help message" << std::endl;
+}
+
+bool parseArguments(int argc, char** argv, HarnessConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        
+        if (arg == "--help") {
+            printUsage();
+            std::exit(0);
+        } else if (arg.find("--algorithms=") == 0) {
+            if (!parseAlgorithmList(arg.substr(13), config.algorithms)) {
+                std::cerr << "Invalid algorithm list: " << arg.substr(13) << std::endl;
+                return false;
+            }
+        } else if (arg.find("--time-limit=") == 0) {
+            config.timeLimitSeconds = std::atof(arg.substr(13).c_str());
+        } else if (arg.find("--filter=") == 0) {
+            config.filter = arg.substr(9);
+        } else if (arg.find("--format=") == 0) {
+            config.format = arg.substr(9);
+            if (config.format != "json" && config.format != "csv") {
+                std::cerr << "Invalid format: " << config.format << std::endl;
+                return false;
+            }
+        } else if (arg.find("--output=") == 0) {
+            config.outputPath = arg.substr(9);
+        } else if (arg.find("--") != 0 && config.manifestPath.empty()) {
+            config.manifestPath = arg;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    
+    if (config.manifestPath.empty()) {
+        std::cerr << "No manifest given" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    HarnessConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        printUsage();
+        return 1;
+    }
+    
+    std::vector<Instance> instances;
+    try {
+        instances = loadManifest(config.manifestPath);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    
+    std::vector<RunReport> reports;
+    
+    for (const auto& instance : instances) {
+        if (!config.filter.empty() && instance.name.find(config.filter) == std::string::npos) {
+            continue;
+        }
+        
+        Graph graph;
+        try {
+            graph = GraphLoader::loadFromFile(instance.path, GraphFileFormat::Dimacs);
+        } catch (const std::exception& e) {
+            std::cerr << "Skipping " << instance.name << ": " << e.what() << std::endl;
+            continue;
+        }
+        
+        // Every algorithm solves the same read-only adjacency
+        CsrGraph csr(graph);
+        
+        for (ColoringAlgorithm algorithm : config.algorithms) {
+            RunReport report = runWithTimeLimit(instance, csr, algorithm, config.timeLimitSeconds);
+            std::cerr << report.instance << " / " << report.algorithm << ": " << report.status;
+            if (report.valid) {
+                std::cerr << ", " << report.colors << " colors (best " << report.bestKnown << ") in "
+                          << report.timeMs << " ms";
+            }
+            std::cerr << std::endl;
+            reports.push_back(report);
+        }
+    }
+    
+    std::ofstream file;
+    if (!config.outputPath.empty()) {
+        file.open(config.outputPath);
+        if (!file) {
+            std::cerr << "Cannot write results: " << config.outputPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = config.outputPath.empty() ? std::cout : file;
+    
+    if (config.format == "json") {
+        writeJson(out, config, reports);
+    } else {
+        writeCsv(out, reports);
+    }
+    printSummary(reports);
+    
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include "perf_counters.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace graph_coloring {
+
+namespace {
+
+#if defined(__linux__)
+// Open one counter for the calling thread on any CPU. The first one opened
+// (groupFd -1) leads the group and starts disabled; the rest follow it.
+int openCounter(uint32_t type, uint64_t config, int groupFd) {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = groupFd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+#endif
+
+} // namespace
+
+double PerfCounters::Sample::ratio(Counter numerator, Counter denominator) const {
+    if (!available[numerator] || !available[denominator] || values[denominator] == 0.0) {
+        return -1.0;
+    }
+    return values[numerator] / values[denominator];
+}
+
+PerfCounters::Sample& PerfCounters::Sample::operator+=(const Sample& other) {
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        available[i] = available[i] || other.available[i];
+        values[i] += other.values[i];
+    }
+    return *this;
+}
+
+PerfCounters::PerfCounters() : leader(-1) {
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        fds[i] = -1;
+    }
+    
+#if defined(__linux__)
+    const uint32_t types[COUNTER_COUNT] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE
+    };
+    const uint64_t configs[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_REFERENCES,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    };
+    
+    // A member that would not fit on the PMU alongside the others is refused
+    // here, so the rest of the group can still be scheduled
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        fds[i] = openCounter(types[i], configs[i], leader);
+        if (leader < 0) {
+            leader = fds[i];
+        }
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        if (fds[i] >= 0) {
+            close(fds[i]);
+        }
+    }
+#endif
+}
+
+bool PerfCounters::isAvailable() const {
+    return leader >= 0;
+}
+
+void PerfCounters::start() {
+#if defined(__linux__)
+    if (leader >= 0) {
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+PerfCounters::Sample PerfCounters::stop() {
+    Sample sample;
+    
+#if defined(__linux__)
+    if (leader < 0) {
+        return sample;
+    }
+    ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    
+    // Group read: count, time enabled, time running, then one value per
+    // member in the order they were opened
+    uint64_t buffer[3 + COUNTER_COUNT] = {};
+    ssize_t size = read(leader, buffer, sizeof(buffer));
+    uint64_t enabled = buffer[1];
+    uint64_t running = buffer[2];
+    if (size < static_cast<ssize_t>(3 * sizeof(uint64_t)) || running == 0) {
+        return sample; // Never scheduled on the PMU
+    }
+    
+    size_t slot = 0;
+    for (int i = 0; i < COUNTER_COUNT && slot < buffer[0]; i++) {
+        if (fds[i] < 0) {
+            continue;
+        }
+        // Scale up when the kernel multiplexed the group with other events
+        sample.available[i] = true;
+        sample.values[i] = static_cast<double>(buffer[3 + slot]) * enabled / running;
+        slot++;
+    }
+#endif
+    
+    return sample;
+}
+
+const char* PerfCounters::counterName(Counter counter) {
+    switch (counter) {
+        case Cycles:
+            return "cycles";
+        case Instructions:
+            return "instructions";
+        case CacheReferences:
+            return "cache_references";
+        case CacheMisses:
+            return "cache_misses";
+        case Branches:
+            return "branches";
+        case BranchMisses:
+            return "branch_misses";
+        case LlcLoadMisses:
+            return "llc_load_misses";
+        default:
+            return "unknown";
+    }
+}
+
+} // namespace graph_coloring
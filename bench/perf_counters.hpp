@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace graph_coloring {
+
+// Hardware performance counters around a measured region (Linux perf_event_open).
+// The counters form one group, so the kernel schedules them together and
+// ratios such as IPC compare counts over the same time. Counters the kernel
+// refuses (no PMU, perf_event_paranoid, more events than the PMU holds at
+// once, other OSes) are reported as unavailable instead of failing the
+// benchmark. Only the calling thread is counted.
+class PerfCounters {
+public:
+    enum Counter {
+        Cycles,
+        Instructions,
+        CacheReferences,
+        CacheMisses,
+        Branches,
+        BranchMisses,
+        LlcLoadMisses,
+        COUNTER_COUNT
+    };
+    
+    struct Sample {
+        bool available[COUNTER_COUNT] = {};
+        double values[COUNTER_COUNT] = {}; // Scaled for multiplexing
+        
+        double ratio(Counter numerator, Counter denominator) const;
+        Sample& operator+=(const Sample& other);
+    };
+
+private:
+    int fds[COUNTER_COUNT];
+    int leader; // First counter opened (normally cycles); -1 if none
+
+public:
+    PerfCounters();
+    ~PerfCounters();
+    
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    
+    // True if at least one counter could be opened
+    bool isAvailable() const;
+    
+    // Reset and start / stop all counters for the calling thread
+    void start();
+    Sample stop();
+    
+    static const char* counterName(Counter counter);
+};
+
+} // namespace graph_coloring
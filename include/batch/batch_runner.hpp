@@ -0,0 +1,80 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../graph/graph.hpp"
+#include "../io/result_writer.hpp"
+#include "../layout/force_layout.hpp"
+#include "../render/rasterizer.hpp"
+
+namespace graph_coloring {
+
+struct BatchOptions {
+    std::vector<std::string> inputs;   // Files, glob patterns or @list files
+    ColoringAlgorithm algorithm = ColoringAlgorithm::Greedy;
+    SolveOptions solve;                // Per-file time/node limits
+    int threads = 0;                   // Files colored at once; 0 = size of the global thread pool
+    std::string outputDir;             // Where per-graph colorings go (empty = don't write)
+    std::string checkpointDir;         // Where per-graph solver checkpoints go (empty = none)
+    std::string imageDir;              // Where per-graph renderings go (empty = don't render)
+    ImageStyle imageStyle;
+    ImageFormat imageFormat = ImageFormat::Png;
+    LayoutAlgorithm layout = LayoutAlgorithm::Circular; // Positions used for the renderings
+    ResultFormat outputFormat = ResultFormat::Text;
+    bool asyncWrite = false;           // Write colorings on a background thread
+    bool validate = true;              // Check each coloring after it is computed
+    // Progress events of each file's solve; called on pool threads
+    std::function<void(const std::string& path, const SolveProgress& progress)> progress;
+};
+
+struct BatchResult {
+    std::string path;
+    bool ok = false;
+    std::string error;
+    int vertexCount = 0;
+    int edgeCount = 0;
+    int colorCount = 0;
+    bool valid = false;
+    double loadMs = 0.0;
+    double colorMs = 0.0;
+    SolverStats stats;
+};
+
+// Colors many graph files concurrently without touching GLFW/OpenGL
+class BatchRunner {
+private:
+    BatchOptions options;
+    std::unique_ptr<AsyncResultWriter> asyncWriter; // Only set during run() with asyncWrite
+    
+    // index is the file's position in the results, name its outputNames entry
+    BatchResult processFile(size_t index, const std::string& path, const std::string& name) const;
+    void writeColoring(size_t index, const std::string& name, Graph& graph) const;
+
+public:
+    explicit BatchRunner(const BatchOptions& options);
+    ~BatchRunner();
+    
+    // Color every input file; results are returned in input order
+    std::vector<BatchResult> run();
+    
+    // Expand glob patterns ("dir/*.col") and @list files into concrete paths
+    static std::vector<std::string> expandInputs(const std::vector<std::string>& patterns);
+    
+    // Names of the per-file outputs (checkpoints, colorings, images; each
+    // adds its extension): the input's path relative to the deepest
+    // directory holding every input, so inputs in different directories
+    // never share an output. One input, or inputs in one directory, keep
+    // their file names; the same file listed twice gets ".<index>" appended.
+    static std::vector<std::string> outputNames(const std::vector<std::string>& paths);
+    
+    // Write a CSV summary of the results
+    static void writeSummary(std::ostream& out, const std::vector<BatchResult>& results);
+    
+    // Write one JSON object per line with each file's solver stats
+    static void writeStats(std::ostream& out, const std::vector<BatchResult>& results);
+};
+
+} // namespace graph_coloring
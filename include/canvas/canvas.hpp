@@ -0,0 +1,144 @@
+#pragma once
+
+// glad provides the GL declarations, so GLFW must not include its own
+#include "graph_renderer.hpp"
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <string>
+#include <vector>
+#include "../graph/graph.hpp"
+#include "../render/camera.hpp"
+#include "../render/level_of_detail.hpp"
+#include "../render/palette.hpp"
+#include "../render/spatial_index.hpp"
+
+
+namespace graph_coloring {
+
+class Canvas {
+private:
+    GLFWwindow* window;
+    int width;
+    int height;
+    std::string title;
+    Graph* graph;
+    
+    // Vertex radius in pixels at zoom 1, and the margin around the layout
+    static constexpr float VERTEX_RADIUS = 15.0f;
+    // Radii stay in this range as the zoom changes
+    static constexpr float MIN_VERTEX_RADIUS = 2.0f;
+    static constexpr float MAX_VERTEX_RADIUS = 40.0f;
+    
+    // Mouse wheel zooms around the cursor, dragging pans
+    Camera camera;
+    bool dragging;
+    bool dragged;       // Moved far enough that the release isn't a click
+    double dragX;
+    double dragY;
+    
+    // Buffered renderer; without GL 3.3 the immediate mode methods below are used
+    GraphRenderer renderer;
+    
+    // Edges as dense index pairs, rebuilt when the structure changes
+    std::vector<int> edgeEndpoints; // Source and target index per edge
+    unsigned long long endpointStructureVersion;
+    
+    // Screen positions by dense vertex index for immediate mode, rebuilt only
+    // when vertices move or the camera changes
+    std::vector<float> screenPositions; // x, y per vertex
+    unsigned long long projectedStructureVersion;
+    unsigned long long projectedPositionVersion;
+    unsigned long long projectedCameraVersion;
+    
+    // Palette covering the current coloring, rebuilt when its color count
+    // changes, and each vertex's entry in it
+    Palette palette;
+    std::vector<int> paletteIndices; // Per dense vertex
+    unsigned long long paletteStructureVersion;
+    unsigned long long paletteColorVersion;
+    
+    // Level of detail: views with too many visible vertices or edges to draw
+    // one by one show density images instead
+    DensityImage vertexCells;
+    DensityImage edgeDensity;
+    
+    // Quadtree over the layout for culling and picking; rebuilt lazily after vertices move
+    SpatialIndex spatialIndex;
+    unsigned long long indexedStructureVersion;
+    unsigned long long indexedPositionVersion;
+    std::vector<int> visibleVertices;
+    std::vector<int> visibleEdges;
+    
+    // Redraw bookkeeping: a frame is only drawn when something changed
+    bool dirty;              // Window resized/exposed or markDirty() called
+    bool projectionDirty;    // Immediate mode projection needs to be set again
+    bool animating;          // Draw every vsync instead of waiting for events
+    unsigned long long drawnStructureVersion;
+    unsigned long long drawnPositionVersion;
+    unsigned long long drawnColorVersion;
+    
+    void updateEdgeEndpoints();
+    void updateProjection();
+    void updateSpatialIndex();
+    void updatePalette();
+    bool needsRedraw() const;
+    
+    // Pixel radius of vertices at the current zoom
+    float vertexRadius() const;
+    // Fill visibleVertices/visibleEdges; false if everything is visible
+    bool cullToViewport(float radius);
+    
+    // Internal rendering methods
+    void renderVertex(int index, const Vertex& vertex, float radius);
+    void renderEdges(const std::vector<int>* subset);
+    void renderImage(const DensityImage& image);
+    void renderText(const std::string& text, float x, float y, float scale);
+    
+    static void windowSizeCallback(GLFWwindow* window, int width, int height);
+    static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
+    static void windowRefreshCallback(GLFWwindow* window);
+    static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+    static void cursorPosCallback(GLFWwindow* window, double x, double y);
+    static void scrollCallback(GLFWwindow* window, double xOffset, double yOffset);
+
+public:
+    Canvas(int width, int height, const std::string& title);
+    ~Canvas();
+    
+    bool initialize();
+    void setGraph(Graph* graph);
+    
+    // Draw a frame if the graph, its coloring or the window changed since the
+    // last one (or always while animating); returns whether it drew
+    bool render();
+    bool shouldClose();
+    void close();
+    
+    // Force the next render() to draw, e.g. after a camera change
+    void markDirty();
+    
+    // While animating, frames are paced by vsync instead of events
+    void setAnimating(bool animating);
+    bool isAnimating() const;
+    
+    // Event handling
+    // Block until an event arrives or timeoutSeconds pass (graph changes made
+    // elsewhere are noticed on the next wakeup); only polls while animating
+    void waitEvents(double timeoutSeconds = 0.25);
+    // Wake a waitEvents() call from any thread
+    static void wake();
+    void processInput();
+    
+    // ID of the vertex drawn at window coordinates (x, y), or -1
+    int pickVertex(double x, double y);
+    
+    // Pan/zoom state; call markDirty() after changing it directly
+    Camera& getCamera();
+    
+    // Utility methods
+    GLFWwindow* getWindow();
+    
+};
+
+} // namespace graph_coloring
+
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <vector>
+#include "../graph/graph.hpp"
+#include "../render/camera.hpp"
+#include "../render/level_of_detail.hpp"
+#include "../render/palette.hpp"
+
+namespace graph_coloring {
+
+// Retained OpenGL 3.3 renderer: vertex positions, colors and edge indices
+// live in GPU buffers that are only re-uploaded when the graph's version
+// stamps change. Edges are one glDrawElements(GL_LINES) call and vertices
+// one instanced draw of a quad that the fragment shader cuts into a circle;
+// each instance looks its fill up by palette index in a palette texture.
+// A culled frame draws only the given vertices and edges, streamed from
+// CPU-side copies of the buffers. Shaders place vertices through the camera,
+// so panning and zooming upload nothing.
+class GraphRenderer {
+private:
+    GLuint circleProgram;
+    GLuint edgeProgram;
+    GLuint imageProgram;
+    GLuint circleArray;   // VAO: quad corners + per-instance position and color
+    GLuint edgeArray;     // VAO: positions + edge index pairs
+    GLuint imageArray;    // VAO: quad corners for density images
+    GLuint imageTexture;
+    GLuint paletteTexture; // Palette RGB, PALETTE_TEXTURE_WIDTH entries per row
+    GLuint quadBuffer;
+    GLuint positionBuffer;
+    GLuint colorBuffer;
+    GLuint edgeBuffer;
+    GLuint subsetCircleArray; // VAOs for culled frames: same layout, streamed buffers
+    GLuint subsetEdgeArray;
+    GLuint subsetPositionBuffer;
+    GLuint subsetColorBuffer;
+    GLuint subsetEdgeBuffer;
+    GLsizei vertexCount;
+    GLsizei edgeIndexCount;
+    bool ready;
+
+    // Version stamps of the data in the buffers; 0 = nothing uploaded
+    unsigned long long structureVersion;
+    unsigned long long edgeVersion; // Structure version of the edge buffer
+    unsigned long long positionVersion;
+    unsigned long long colorVersion;
+    int paletteColorCount; // Of the palette in the texture; -1 = nothing uploaded
+
+    // What the buffers hold, to gather culled subsets from
+    std::vector<float> positions;
+    std::vector<GLint> colors;
+    std::vector<float> subsetPositions;
+    std::vector<GLint> subsetColors;
+    std::vector<GLuint> subsetEdgeIndices;
+
+    void update(Graph& graph);
+    void setView(GLuint program, const Camera& camera);
+    void uploadStructure(Graph& graph);
+    void uploadEdges(Graph& graph, const std::vector<int>& edgeEndpoints);
+    void uploadPositions(Graph& graph);
+    void uploadColors(Graph& graph, const Palette& palette);
+    void uploadPalette(const Palette& palette);
+
+public:
+    GraphRenderer();
+    ~GraphRenderer();
+
+    GraphRenderer(const GraphRenderer&) = delete;
+    GraphRenderer& operator=(const GraphRenderer&) = delete;
+
+    // Needs a current context with GL 3.3; false means the caller should
+    // draw another way (e.g. an older driver or a legacy-only context)
+    bool initialize();
+    bool isReady() const { return ready; }
+
+    // Draw the graph as seen by the camera: edges as lines, vertices as circles
+    // of the given pixel radius filled from palette.
+    // A non-null subset restricts the draw to those dense edge or vertex indices.
+    // edgeEndpoints is the graph's Graph::getEdgeEndpoints(), kept by the caller.
+    void drawEdges(Graph& graph, const std::vector<int>& edgeEndpoints, const Camera& camera,
+                   const std::vector<int>* subset = nullptr);
+    void drawVertices(Graph& graph, const Camera& camera, float radius, const Palette& palette,
+                      const std::vector<int>* subset = nullptr);
+
+    // Blend a level-of-detail image over the window
+    void drawImage(const DensityImage& image, const Camera& camera);
+
+    // Delete the GL objects; the context must still be current
+    void release();
+};
+
+} // namespace graph_coloring
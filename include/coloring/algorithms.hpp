@@ -0,0 +1,81 @@
+#pragma once
+
+#include <random>
+#include <vector>
+#include "../graph/csr_graph.hpp"
+#include "../graph/solver_stats.hpp"
+#include "../parallel/cancellation.hpp"
+#include "checkpoint.hpp"
+#include "progress.hpp"
+
+namespace graph_coloring {
+
+// Individual coloring algorithms used by solveColoring. They work on dense
+// CSR indices and write coloring[index]; none of them modify the graph.
+// Algorithms that take a cancellation token give up (and return false or
+// Aborted) soon after it is cancelled; their coloring is then incomplete.
+namespace algorithms {
+
+// Outcome of a search for a coloring with a fixed number of colors
+enum class SearchResult {
+    Found,
+    Infeasible,
+    Aborted
+};
+
+// Vertex orders for greedy coloring
+std::vector<int> insertionOrder(const CsrGraph& csr);
+std::vector<int> largestDegreeOrder(const CsrGraph& csr);
+std::vector<int> smallestLastOrder(const CsrGraph& csr); // Degeneracy order, reversed
+
+// Color vertices in the given order with the smallest color unused by their neighbors
+void greedyColoring(const CsrGraph& csr, const std::vector<int>& order, std::vector<int>& coloring);
+
+// DSATUR: always color the vertex with the most distinct neighbor colors next
+bool dsaturColoring(const CsrGraph& csr, std::vector<int>& coloring, const CancellationToken* cancel = nullptr);
+
+// Recursive largest first: build one maximal independent color class at a time
+bool rlfColoring(const CsrGraph& csr, std::vector<int>& coloring, const CancellationToken* cancel = nullptr);
+
+// Tabu search (Tabucol) for a conflict-free coloring with numColors colors,
+// starting from coloring (out-of-range colors are replaced at random).
+// Runs at most maxIterations moves; coloring holds the current state on return.
+bool tabuSearch(const CsrGraph& csr, int numColors, std::vector<int>& coloring, std::mt19937& rng,
+                long long maxIterations, const CancellationToken* cancel = nullptr);
+
+// Size of a clique found greedily from the highest degree vertices; a lower bound on the colors needed
+int greedyCliqueSize(const CsrGraph& csr);
+
+// Backtracking search for a minimum coloring: starts from a greedy coloring
+// and searches for one color fewer until that is infeasible (Found, the
+// coloring is optimal) or a limit stops it (Aborted). Either way coloring
+// holds the best complete coloring found. nodeLimit <= 0 means no limit.
+// Each better coloring and each bound proved is reported to progress. With a
+// checkpointer the search state is saved periodically and when it stops, and
+// a resumed checkpoint is continued from where it was left.
+SearchResult exactColoring(const CsrGraph& csr, std::vector<int>& coloring, SolverStats& stats,
+                           const CancellationToken* cancel = nullptr, long long nodeLimit = 0,
+                           ProgressReporter* progress = nullptr, Checkpointer* checkpointer = nullptr);
+
+// Backtracking search for a coloring with at most numColors colors. With
+// startDepth > 0, coloring[0..startDepth) is a path saved by an earlier search
+// for the same numColors, and the search continues from there.
+SearchResult exactColoringWithin(const CsrGraph& csr, int numColors, std::vector<int>& coloring,
+                                 SolverStats& stats, const CancellationToken* cancel = nullptr,
+                                 long long nodeLimit = 0, Checkpointer* checkpointer = nullptr,
+                                 int startDepth = 0);
+
+// Race the algorithms above as tasks on the global thread pool, sharing the best upper bound
+// and the best lower bound; stops when they meet (Found), the budget runs out
+// or cancel is cancelled (Aborted). coloring always ends up complete.
+// Every member's improvements are reported to progress as they happen. With a
+// checkpointer the best coloring, the exact member's frontier and the local
+// search state are saved periodically and resumed from.
+SearchResult portfolioColoring(const CsrGraph& csr, double timeBudgetSeconds, std::vector<int>& coloring,
+                               SolverStats& stats, const CancellationToken* cancel = nullptr,
+                               long long nodeLimit = 0, ProgressReporter* progress = nullptr,
+                               Checkpointer* checkpointer = nullptr);
+
+} // namespace algorithms
+
+} // namespace graph_coloring
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include "../graph/csr_graph.hpp"
+
+namespace graph_coloring {
+
+// What an interrupted exact or portfolio solve needs to continue
+struct SearchCheckpoint {
+    std::string algorithm;   // coloringAlgorithmName of the run that wrote it
+    uint64_t graphHash = 0;  // checkpointGraphHash of the colored graph
+    std::vector<int> best;   // Best complete coloring so far; empty if none
+    int lowerBound = 0;
+
+    // Exact search frontier: the search for at most exactTarget colors had
+    // assigned exactPath to vertices 0..size-1, and every branch before that
+    // path is exhausted. exactTarget 0 = no search in progress.
+    int exactTarget = 0;
+    std::vector<int> exactPath;
+
+    // Local search state at the end of its last round; localTarget 0 = none
+    int localTarget = 0;
+    std::vector<int> localColoring;
+    std::string localRngState; // std::mt19937 in its stream format
+};
+
+// Fingerprint of the adjacency, so a checkpoint is never resumed on another graph
+uint64_t checkpointGraphHash(const CsrGraph& csr);
+
+// Compact binary file in native byte order. Written to a temporary file and
+// renamed over the old one, so a preempted write never leaves a torn checkpoint.
+void writeCheckpoint(const std::string& path, const SearchCheckpoint& checkpoint);
+
+// False if there is no file at path; throws if it isn't a valid checkpoint
+bool readCheckpoint(const std::string& path, SearchCheckpoint& checkpoint);
+
+// Collects checkpoint state from the search threads of one solve and writes
+// it every interval. Searches call isDue() where they poll for cancellation.
+class Checkpointer {
+private:
+    std::string path;
+    std::chrono::steady_clock::duration interval;
+    std::atomic<std::chrono::steady_clock::rep> nextSave;
+    mutable std::mutex mutex;
+    SearchCheckpoint state;
+    SearchCheckpoint resumed;
+    bool hasResumed;
+
+public:
+    Checkpointer(const std::string& path, double intervalSeconds, const CsrGraph& csr, const char* algorithm);
+
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    // Load the checkpoint at path if there is one; throws if it was written
+    // for another graph or algorithm
+    bool resume();
+
+    // The loaded checkpoint, or nullptr; never changes after resume()
+    const SearchCheckpoint* getResumed() const { return hasResumed ? &resumed : nullptr; }
+
+    bool isDue() const;
+
+    void updateBest(const std::vector<int>& best, int lowerBound);
+    void updateExact(int target, const std::vector<int>& coloring, int depth);
+    void updateLocalSearch(int target, const std::vector<int>& coloring, const std::mt19937& rng);
+
+    void save();
+    void saveIfDue();
+
+    // Remove the file once the solve has finished for good
+    void discard();
+};
+
+} // namespace graph_coloring
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "coloring_algorithm.hpp"
+#include "solve_options.hpp"
+#include "../graph/solver_stats.hpp"
+
+namespace graph_coloring {
+
+// Result of one solver run, independent of the Graph it was computed from.
+// colors[i] is the color of CSR index i (the i-th vertex of Graph::getVertices).
+// Immutable once built: copies share the color array, and any thread may read it.
+class Coloring {
+private:
+    std::shared_ptr<const std::vector<int>> colors;
+    int numColors;
+    ColoringAlgorithm algorithm;
+    SolveStatus status;
+    SolverStats stats;
+
+public:
+    Coloring();
+    Coloring(std::vector<int> colors, ColoringAlgorithm algorithm, const SolverStats& stats,
+             SolveStatus status = SolveStatus::Complete);
+    Coloring(const Coloring& other, const SolverStats& stats); // Same colors, replaced stats
+
+    // Getters
+    const std::vector<int>& getColors() const;
+    int getColor(int index) const;
+    int getNumberOfColors() const;
+    int getVertexCount() const;
+    ColoringAlgorithm getAlgorithm() const;
+    SolveStatus getStatus() const; // Whether the solver finished or a limit stopped it
+    const SolverStats& getStats() const;
+
+    // Utility methods
+    bool isValid() const;
+    bool isEmpty() const;
+};
+
+} // namespace graph_coloring
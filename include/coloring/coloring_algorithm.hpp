@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace graph_coloring {
+
+enum class ColoringAlgorithm {
+    Greedy,
+    SF,
+    Exact,
+    SmallestLast,
+    DSatur,
+    RLF,
+    Portfolio
+};
+
+// Command-line names for the coloring algorithms ("greedy", "sf", "exact",
+// "sl", "dsatur", "rlf", "portfolio")
+const char* coloringAlgorithmName(ColoringAlgorithm algorithm);
+bool parseColoringAlgorithm(const std::string& name, ColoringAlgorithm& algorithm);
+
+// Every single algorithm; Portfolio is left out since it runs all of them
+// until its time budget and has to be asked for explicitly
+std::vector<ColoringAlgorithm> allColoringAlgorithms();
+
+} // namespace graph_coloring
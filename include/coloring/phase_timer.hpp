@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include "../trace/trace.hpp"
+
+namespace graph_coloring {
+
+// Times one solver phase into a SolverStats field; also a trace zone when tracing is compiled in
+class PhaseTimer {
+private:
+    const char* name;
+    double& elapsed;
+    std::chrono::steady_clock::time_point start;
+#ifdef GRAPHCOLORING_TRACING
+    std::optional<TraceScope> zone; // Closed by stop(), not only at destruction
+#endif
+
+public:
+    PhaseTimer(const char* name, double& elapsed)
+        : name(name), elapsed(elapsed), start(std::chrono::steady_clock::now()) {
+#ifdef GRAPHCOLORING_TRACING
+        zone.emplace(name);
+#endif
+    }
+    
+    ~PhaseTimer() {
+        stop();
+    }
+    
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+    
+    void stop() {
+        if (name) {
+            std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+            elapsed = duration.count();
+            name = nullptr;
+#ifdef GRAPHCOLORING_TRACING
+            zone.reset();
+#endif
+        }
+    }
+};
+
+} // namespace graph_coloring
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+namespace graph_coloring {
+
+enum class ProgressEvent {
+    Improved,    // A coloring with fewer colors was found
+    LowerBound,  // A larger lower bound was proved
+    Finished     // The solve returned; colors is the final count
+};
+
+// "improved", "lower_bound" or "finished"
+const char* progressEventName(ProgressEvent event);
+
+// One improvement during a solve
+struct SolveProgress {
+    ProgressEvent event = ProgressEvent::Improved;
+    const char* source = "";     // Algorithm behind the event, e.g. a portfolio member; a string literal
+    int colors = 0;              // Best color count so far (0 before the first coloring)
+    int lowerBound = 0;          // Best proven lower bound so far (0 if none)
+    double elapsedMs = 0.0;      // Since the solve started
+    long long nodesExplored = 0; // Exact search assignments so far
+};
+
+// Called on the solver's threads, never concurrently for one solve. It should
+// return quickly, e.g. by pushing into a BoundedQueue drained elsewhere.
+using ProgressCallback = std::function<void(const SolveProgress&)>;
+
+// Turns bound updates into progress events, dropping those that don't
+// improve on what was already reported. Not thread-safe; callers that
+// report from several threads serialize through their own lock.
+class ProgressReporter {
+private:
+    const ProgressCallback* callback;
+    std::chrono::steady_clock::time_point start;
+    int colors;
+    int lowerBound;
+
+    void emit(ProgressEvent event, const char* source, long long nodesExplored);
+
+public:
+    ProgressReporter(const ProgressCallback* callback, std::chrono::steady_clock::time_point start);
+
+    bool isEnabled() const { return callback && *callback; }
+
+    void improve(int colors, const char* source, long long nodesExplored);
+    void raiseLowerBound(int bound, const char* source, long long nodesExplored);
+    void finish(int colors, int lowerBound, const char* source, long long nodesExplored);
+};
+
+} // namespace graph_coloring
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../parallel/cancellation.hpp"
+#include "progress.hpp"
+#include <string>
+
+namespace graph_coloring {
+
+// Limits for one solve. Every limit is optional; when one is hit the solver
+// returns the best coloring it has so far with a status saying why it stopped.
+struct SolveOptions {
+    double timeLimitSeconds = 0.0;                  // Wall clock from the start of the solve; 0 = none
+    long long nodeLimit = 0;                        // Exact search assignments; 0 = none
+    const CancellationToken* cancellation = nullptr; // Cancelled by the caller, e.g. on another thread
+    ProgressCallback progress;                      // Improvement events while solving; optional
+    // Exact and portfolio solves save their search state here every
+    // checkpointIntervalSeconds and when they stop early; empty = never
+    std::string checkpointPath;
+    double checkpointIntervalSeconds = 60.0;
+    bool resume = false;                            // Continue from checkpointPath if it exists
+};
+
+enum class SolveStatus {
+    Complete,  // The algorithm ran to the end
+    Optimal,   // Ran to the end and proved the color count minimal
+    TimeLimit, // Stopped at timeLimitSeconds
+    NodeLimit, // Stopped at nodeLimit
+    Cancelled  // Stopped through the cancellation token
+};
+
+// "complete", "optimal", "time_limit", "node_limit" or "cancelled"
+const char* solveStatusName(SolveStatus status);
+
+} // namespace graph_coloring
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "coloring.hpp"
+#include "solve_options.hpp"
+#include "../graph/csr_graph.hpp"
+
+namespace graph_coloring {
+
+// Time budget of ColoringAlgorithm::Portfolio when options set no time limit;
+// it returns earlier once the best coloring is proven optimal
+const double DEFAULT_PORTFOLIO_BUDGET_SECONDS = 10.0;
+
+// Color a read-only CSR graph and return the result as a standalone Coloring.
+// Only reads csr, so any number of threads may solve the same CsrGraph
+// concurrently (with the same or different algorithms) without locking.
+// Exact, DSATUR, RLF and portfolio stop at the limits in options; vertices
+// they left uncolored are then colored greedily, so the result is always a
+// complete coloring and getStatus() tells whether it was cut short. The
+// greedy orders are linear-time and always run to the end.
+Coloring solveColoring(const CsrGraph& csr, ColoringAlgorithm algorithm,
+                       const SolveOptions& options = SolveOptions());
+
+} // namespace graph_coloring
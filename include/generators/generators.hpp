@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include "../graph/graph.hpp"
+
+namespace graph_coloring {
+
+// Builders for standard test graphs, with vertex positions in [0, 1] for display
+class GraphGenerator {
+public:
+    // Complete graph K_n with vertices on a circle
+    static Graph complete(int numVertices);
+    
+    // Cycle C_n with vertices on a circle
+    static Graph cycle(int numVertices);
+    
+    // rows x cols grid, each vertex connected to its right and bottom neighbor
+    static Graph grid(int rows, int cols);
+    
+    // One center vertex connected to numRays outer vertices
+    static Graph star(int numRays);
+    
+    // The Petersen graph (10 vertices, chromatic number 3)
+    static Graph petersen();
+    
+    // Erdos-Renyi G(n, p) graph with random positions
+    static Graph random(int numVertices, double edgeProbability, uint32_t seed);
+    
+    // Random geometric graph: vertices closer than radius are connected
+    static Graph randomGeometric(int numVertices, double radius, uint32_t seed);
+};
+
+} // namespace graph_coloring
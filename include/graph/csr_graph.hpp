@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace graph_coloring {
+
+class Graph;
+
+// Compressed sparse row adjacency over dense vertex indices (0..n-1, in the
+// order of Graph::getVertices). Built once per solve; read-only afterwards.
+class CsrGraph {
+private:
+    std::vector<int> offsets;   // neighbors of i are neighbors[offsets[i] .. offsets[i + 1])
+    std::vector<int> neighbors; // Dense indices, each undirected edge stored in both directions
+    std::vector<int> vertexIds; // Dense index -> vertex ID
+    std::vector<int> edgeSources; // Dense edge array: edge i joins edgeSources[i] and edgeTargets[i]
+    std::vector<int> edgeTargets;
+
+    // Fill offsets and neighbors from the edge arrays
+    void buildAdjacency(int vertexCount);
+
+public:
+    CsrGraph();
+    explicit CsrGraph(const Graph& graph);
+    // Vertices 0..vertexCount-1 (IDs equal to indices) joined by the given
+    // edges, which must be free of duplicates and self loops (e.g. a coarsened graph)
+    CsrGraph(int vertexCount, std::vector<int> edgeSources, std::vector<int> edgeTargets);
+
+    int getVertexCount() const { return static_cast<int>(vertexIds.size()); }
+    int getEdgeCount() const { return static_cast<int>(edgeSources.size()); }
+    int getDegree(int index) const { return offsets[index + 1] - offsets[index]; }
+    int getVertexId(int index) const { return vertexIds[index]; }
+
+    // Neighbor range of a vertex as [begin, end)
+    const int* neighborsBegin(int index) const { return neighbors.data() + offsets[index]; }
+    const int* neighborsEnd(int index) const { return neighbors.data() + offsets[index + 1]; }
+
+    // Each undirected edge once, as parallel endpoint arrays (for streaming passes)
+    const std::vector<int>& getEdgeSources() const { return edgeSources; }
+    const std::vector<int>& getEdgeTargets() const { return edgeTargets; }
+
+    // Bytes held by the adjacency arrays
+    size_t memoryBytes() const;
+};
+
+} // namespace graph_coloring
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <random>
+#include "../vertex/vertex.hpp"
+#include "../edge/edge.hpp"
+#include "csr_graph.hpp"
+#include "solver_stats.hpp"
+#include "validation.hpp"
+#include "../coloring/coloring.hpp"
+
+namespace graph_coloring {
+
+class Graph {
+private:
+    std::vector<Vertex> vertices;
+    std::vector<Edge> edges;
+    std::unordered_map<int, int> vertexColors; // Maps vertex ID to color
+    std::unordered_map<int, size_t> vertexIndex; // Maps vertex ID to its position in vertices
+    std::unordered_set<long long> edgeKeys;      // Normalized (min, max) ID pairs of existing edges
+    bool verbose;                                // Print progress messages while coloring
+    SolverStats lastStats;                       // Filled in by colorGraph
+    
+    // Change stamps for caches of the graph (e.g. GPU buffers). Stamps are
+    // unique across all graphs, so a cache can't mistake a reassigned graph
+    // for the one it saw last.
+    unsigned long long structureVersion; // Vertices or edges added/removed
+    unsigned long long positionVersion;  // Vertex coordinates changed
+    unsigned long long colorVersion;     // Coloring changed
+    
+    static long long edgeKey(int sourceId, int targetId);
+    static unsigned long long nextVersion();
+    
+public:
+    Graph();
+    ~Graph();
+
+    // Vertex operations
+    void addVertex(const Vertex& vertex);
+    void addVertex(float x, float y);
+    Vertex* getVertex(int id);
+    std::vector<Vertex>& getVertices();
+    const std::vector<Vertex>& getVertices() const;
+    int getVertexIndex(int id) const; // Position in getVertices(), -1 if missing
+
+    // Edge operations
+    void addEdge(const Edge& edge);
+    void addEdge(int sourceId, int targetId);
+    Edge* getEdge(int sourceId, int targetId);
+    std::vector<Edge>& getEdges();
+    const std::vector<Edge>& getEdges() const;
+    std::vector<int> getAdjacentVertexIds(int vertexId);
+    // Dense source, target index per edge whose endpoints exist, in edge order
+    std::vector<int> getEdgeEndpoints() const;
+
+    // Coloring operations
+    void colorGraph(ColoringAlgorithm algorithm = ColoringAlgorithm::Greedy,
+                    const SolveOptions& options = SolveOptions());
+    Coloring computeColoring(ColoringAlgorithm algorithm = ColoringAlgorithm::Greedy,
+                             const SolveOptions& options = SolveOptions()) const; // Leaves the graph untouched
+    void applyColoring(const Coloring& coloring);
+    bool isValidColoring();
+    ValidationResult validateColoring(bool collectConflicts = false);
+    int getVertexColor(int vertexId) const;
+    void setVertexColor(int vertexId, int color);
+    int getNumberOfColors();
+    const SolverStats& getLastStats() const;
+
+    // Utility methods
+    void clear();
+    bool isEmpty();
+    int getVertexCount();
+    int getEdgeCount();
+    void setVerbose(bool verbose);
+    
+    // Change tracking; vertices moved through getVertices()/getVertex() must
+    // be followed by markPositionsChanged()
+    unsigned long long getStructureVersion() const { return structureVersion; }
+    unsigned long long getPositionVersion() const { return positionVersion; }
+    unsigned long long getColorVersion() const { return colorVersion; }
+    void markPositionsChanged();
+};
+
+} // namespace graph_coloring
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace graph_coloring {
+
+// What happened during the last Graph::colorGraph call
+struct SolverStats {
+    std::string algorithm;
+    
+    // Phase timings in milliseconds
+    double buildAdjacencyMs = 0.0;
+    double orderingMs = 0.0;
+    double coloringMs = 0.0;
+    double validationMs = 0.0;
+    double totalMs = 0.0;
+    
+    // Search counters (exact coloring)
+    long long nodesExplored = 0;  // Color assignments attempted
+    long long backtracks = 0;     // Assignments undone after a failed subtree
+    long long prunedBranches = 0; // Colors rejected because a neighbor already had them
+    
+    // Conflicting vertices recolored in each round of speculative parallel algorithms
+    std::vector<long long> conflictsPerRound;
+    
+    // Result
+    int vertices = 0;
+    int edges = 0;
+    int colors = 0;
+    long long conflicts = 0; // Edges with equal colors found by validation
+    bool valid = false;
+    
+    // Exact and portfolio runs
+    int lowerBound = 0;        // Proven lower bound on the colors needed (0 if none)
+    std::string bestAlgorithm; // Portfolio member that found the returned coloring
+    
+    std::string status;        // solveStatusName of the run: why the solver stopped
+    
+    // Memory
+    size_t solverMemoryBytes = 0; // Adjacency and per-vertex work arrays held by the solver
+    size_t peakRssBytes = 0;      // Process peak resident set size after the solve
+    
+    std::string toJson() const;
+};
+
+// Peak resident set size of the current process in bytes (0 if unavailable)
+size_t currentPeakRssBytes();
+
+} // namespace graph_coloring
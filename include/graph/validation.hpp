@@ -0,0 +1,26 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+#include "csr_graph.hpp"
+
+namespace graph_coloring {
+
+struct ValidationResult {
+    long long conflicts = 0;      // Edges whose endpoints share a color
+    long long uncoloredEdges = 0; // Edges with an endpoint that has no color (< 0)
+    
+    // Dense index pairs of the conflicting edges, only filled on request
+    std::vector<std::pair<int, int>> conflictEdges;
+    
+    bool isValid() const { return conflicts == 0 && uncoloredEdges == 0; }
+};
+
+// Check a dense coloring (coloring[i] for CSR index i) against every edge.
+// Streams the CSR edge arrays in parallel chunks and uses AVX2 gathers when
+// the CPU supports them. threads is the number of chunks; <= 0 uses one
+// per worker of the global thread pool.
+ValidationResult validateColoring(const CsrGraph& csr, const std::vector<int>& coloring,
+                                  bool collectConflicts = false, int threads = 0);
+
+} // namespace graph_coloring
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+namespace graph_coloring {
+
+// Quoted CSV field (RFC 4180): embedded quotes are doubled, so commas,
+// quotes and line breaks in paths, names and error messages stay in their column
+std::string csvField(const std::string& text);
+
+} // namespace graph_coloring
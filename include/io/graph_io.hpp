@@ -0,0 +1,31 @@
+#pragma once
+
+#include <istream>
+#include <string>
+#include "../graph/graph.hpp"
+
+namespace graph_coloring {
+
+enum class GraphFileFormat {
+    Auto,      // Detect from the file extension / contents
+    Dimacs,    // DIMACS .col format ("p edge n m" / "e u v")
+    EdgeList   // One "u v" pair per line
+};
+
+class GraphLoader {
+public:
+    // Load a graph from disk, throws std::runtime_error on I/O or parse errors
+    static Graph loadFromFile(const std::string& path, GraphFileFormat format = GraphFileFormat::Auto);
+
+    // Parsers for the individual formats
+    static Graph loadDimacs(std::istream& input);
+    static Graph loadEdgeList(std::istream& input);
+
+    // Guess the format of a file from its extension
+    static GraphFileFormat detectFormat(const std::string& path);
+
+    // Place vertices on a circle so loaded graphs are drawable without a layout
+    static void assignCircularLayout(Graph& graph);
+};
+
+} // namespace graph_coloring
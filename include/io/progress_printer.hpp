@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include "../coloring/progress.hpp"
+#include "../parallel/bounded_queue.hpp"
+
+namespace graph_coloring {
+
+// Prints progress events to stderr on its own thread; solver threads only
+// push into a lock-free queue and drop the event if the printer falls behind
+class ProgressPrinter {
+private:
+    struct Line {
+        std::string label;
+        SolveProgress progress;
+    };
+
+    BoundedQueue<Line> queue;
+    std::atomic<bool> done;
+    std::atomic<long long> dropped;
+    std::thread thread;
+
+    void drain();
+
+public:
+    ProgressPrinter();
+    // Prints what is still queued and how many events were dropped
+    ~ProgressPrinter();
+
+    ProgressPrinter(const ProgressPrinter&) = delete;
+    ProgressPrinter& operator=(const ProgressPrinter&) = delete;
+
+    void push(const std::string& label, const SolveProgress& progress);
+};
+
+} // namespace graph_coloring
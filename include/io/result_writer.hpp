@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../graph/graph.hpp"
+
+namespace graph_coloring {
+
+enum class ResultFormat {
+    Text,       // "<vertex id> <color>" per line, written with a single buffered write
+    Binary,     // Raw native-endian int32 colors in vertex order, no header
+    ClassLists  // One line per color class: "<color>: <vertex id> <vertex id> ..."
+};
+
+// Snapshot of a coloring detached from the Graph so it can be written later
+struct ColoringRecord {
+    std::vector<int> vertexIds;
+    std::vector<int> colors; // colors[i] belongs to vertexIds[i]
+    
+    static ColoringRecord fromGraph(Graph& graph);
+};
+
+class ResultWriter {
+public:
+    // Serialize a coloring into a buffer / stream / file
+    static std::string format(const ColoringRecord& record, ResultFormat format);
+    static void write(std::ostream& out, const ColoringRecord& record, ResultFormat format);
+    static void writeFile(const std::string& path, const ColoringRecord& record, ResultFormat format);
+    
+    // File extension used for each format (".colors", ".bin", ".classes")
+    static const char* extension(ResultFormat format);
+    static bool parseFormat(const std::string& name, ResultFormat& format);
+};
+
+// Writes results on a background thread so the caller can start the next job
+class AsyncResultWriter {
+public:
+    // A write that failed, by the id it was submitted with
+    struct WriteError {
+        size_t id;
+        std::string message;
+    };
+
+private:
+    struct Job {
+        size_t id;
+        std::string path;
+        ColoringRecord record;
+        ResultFormat format;
+    };
+    
+    std::deque<Job> queue;
+    std::mutex mutex;
+    std::condition_variable queueChanged;
+    std::thread worker;
+    size_t pending;
+    bool stopping;
+    std::vector<WriteError> errors; // Since the last flush
+    
+    void workerLoop();
+
+public:
+    AsyncResultWriter();
+    ~AsyncResultWriter();
+    
+    AsyncResultWriter(const AsyncResultWriter&) = delete;
+    AsyncResultWriter& operator=(const AsyncResultWriter&) = delete;
+    
+    // Queue a coloring to be written to path; returns immediately. id is the
+    // caller's handle for the result, reported back if the write fails.
+    void submit(size_t id, const std::string& path, ColoringRecord record, ResultFormat format);
+    
+    // Block until every queued result has been written or has failed;
+    // returns the failures since the last flush
+    std::vector<WriteError> flush();
+};
+
+} // namespace graph_coloring
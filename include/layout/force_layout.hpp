@@ -0,0 +1,115 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "../graph/csr_graph.hpp"
+#include "../graph/graph.hpp"
+
+namespace graph_coloring {
+
+struct ForceLayoutOptions {
+    float scalingRatio = 2.0f;     // Repulsion strength; larger spreads the layout out
+    float gravity = 1.0f;          // Pull toward the center that keeps components together
+    float theta = 1.2f;            // Barnes-Hut opening ratio; 0 computes exact repulsion
+    float jitterTolerance = 1.0f;  // Oscillation tolerated before the layout slows down
+    float tolerance = 0.0001f;     // Converged once the mean step is below this fraction of the layout size
+    int maxIterations = 1000;
+    unsigned int seed = 1;         // For the random initial positions
+};
+
+// ForceAtlas2 force-directed layout. Every vertex repels every other with a
+// force proportional to (degree + 1) of both over their distance, edges pull
+// their endpoints together linearly and a weak gravity keeps components
+// close. Repulsion is approximated with a Barnes-Hut quadtree rebuilt every
+// step. The vertices of each leaf share one interaction list: cells far from
+// the whole leaf (as one point at their center of mass) and the vertices of
+// nearby leaves. Each vertex then sums its repulsion over the list in one
+// vectorized pass (AVX2 when the CPU has it). Leaves are processed in
+// parallel on the thread pool. Each vertex's step size adapts to how much
+// its force oscillates, as in ForceAtlas2.
+//
+// The layout works on its own copy of the positions, one step at a time, so
+// a viewer can apply() after each step and animate the layout converging.
+class ForceLayout {
+private:
+    struct Cell {
+        float minX;      // The cell's square
+        float minY;
+        float size;
+        float massX;     // Center of mass
+        float massY;
+        float mass;
+        int firstChild;  // Four consecutive children, or -1 for a leaf
+        int bodyBegin;   // Range of the cell's vertices in body order
+        int bodyEnd;
+    };
+
+    CsrGraph csr;
+    ForceLayoutOptions options;
+    std::vector<float> x;           // Positions by dense index
+    std::vector<float> y;
+    std::vector<float> mass;        // Degree + 1
+    std::vector<float> forceX;
+    std::vector<float> forceY;
+    std::vector<float> previousForceX;
+    std::vector<float> previousForceY;
+    std::vector<float> swinging;    // Per vertex: mass * |force - previous force|
+    std::vector<float> traction;    // Per vertex: mass * |force + previous force| / 2
+    float speed;
+    float speedEfficiency;
+    int iteration;
+    bool converged;
+
+    // Barnes-Hut tree over the current positions
+    std::vector<Cell> cells;
+    std::vector<int> leaves;        // Non-empty leaf cells
+    std::vector<int> bodyOrder;     // Dense indices grouped by cell
+    std::vector<float> bodyX;       // Positions and masses in body order
+    std::vector<float> bodyY;
+    std::vector<float> bodyMass;
+
+    void randomizePositions();
+    void buildTree();
+    void split(int cell, int depth);
+    void computeForces();
+    void moveVertices();
+
+public:
+    explicit ForceLayout(const Graph& graph, const ForceLayoutOptions& options = ForceLayoutOptions());
+    explicit ForceLayout(CsrGraph csr, const ForceLayoutOptions& options = ForceLayoutOptions());
+
+    // Start from these positions (dense order) instead of random ones
+    void setPositions(const std::vector<float>& x, const std::vector<float>& y);
+
+    // One iteration; returns false once the layout has converged or hit maxIterations
+    bool step();
+    // Step until converged
+    void run();
+
+    int getIteration() const { return iteration; }
+    bool isConverged() const { return converged; }
+    const std::vector<float>& getX() const { return x; }
+    const std::vector<float>& getY() const { return y; }
+
+    // Write the positions into the graph (the one the layout was built from),
+    // scaled uniformly into the unit square, and mark them changed
+    void apply(Graph& graph) const;
+};
+
+enum class LayoutAlgorithm {
+    Circular,  // Vertices evenly spaced on a circle (what the loaders assign)
+    Force,     // ForceLayout run to convergence
+    Multilevel // MultilevelLayout (multilevel_layout.hpp), for large graphs
+};
+
+// Write layout coordinates (dense order) into the graph, scaled uniformly
+// into the unit square, and mark them changed
+void applyLayout(Graph& graph, const std::vector<float>& x, const std::vector<float>& y);
+
+// Parse "circular", "force" or "multilevel"; false if the name is unknown
+bool parseLayoutAlgorithm(const std::string& name, LayoutAlgorithm& algorithm);
+
+// Lay out the whole graph in place
+void layoutGraph(Graph& graph, LayoutAlgorithm algorithm);
+
+} // namespace graph_coloring
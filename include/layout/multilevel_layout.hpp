@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+#include "../graph/csr_graph.hpp"
+#include "../graph/graph.hpp"
+#include "force_layout.hpp"
+
+namespace graph_coloring {
+
+struct MultilevelLayoutOptions {
+    ForceLayoutOptions force;     // Used on every level; maxIterations is set per level
+    int coarsestSize = 100;       // Stop coarsening at this many vertices
+    int refineIterations = 20;    // Steps on the input graph; a level k times smaller gets sqrt(k) times more
+    int coarsestIterations = 500; // Steps on the coarsest level, and the most any level gets
+    unsigned int seed = 1;        // Matching order and placement jitter
+};
+
+// Multilevel force-directed layout for graphs too large for ForceLayout to
+// untangle from random positions. The graph is coarsened repeatedly by
+// matching each vertex with a neighbor (vertices left unmatched join a
+// neighbor's pair) until it is small; the coarsest graph is laid out from
+// scratch, and each finer level starts from its coarse vertex's position
+// and is refined by a few ForceLayout steps. Most of the untangling happens
+// on small graphs, so the input graph only needs a short refinement.
+// Finally the connected components are packed side by side.
+class MultilevelLayout {
+private:
+    MultilevelLayoutOptions options;
+    std::vector<CsrGraph> levels;        // levels[0] is the input graph
+    std::vector<std::vector<int>> parents; // parents[l][v]: vertex of level l + 1 that v of level l merged into
+    std::vector<float> x;                // Final positions, dense order
+    std::vector<float> y;
+
+    void coarsen();
+
+public:
+    explicit MultilevelLayout(const Graph& graph,
+                              const MultilevelLayoutOptions& options = MultilevelLayoutOptions());
+
+    int getLevelCount() const { return static_cast<int>(levels.size()); }
+    int getLevelSize(int level) const { return levels[level].getVertexCount(); }
+
+    // Lay out every level, coarsest first
+    void run();
+
+    // Write the positions into the graph, scaled uniformly into the unit
+    // square, and mark them changed
+    void apply(Graph& graph) const;
+};
+
+} // namespace graph_coloring
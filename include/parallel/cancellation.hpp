@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace graph_coloring {
+
+// Cooperative cancellation shared between a requester and long-running work.
+// Cancelled explicitly, once the optional deadline has passed or when the
+// optional parent token is. Reading the clock is not free, so tight loops
+// should only poll every few hundred steps.
+class CancellationToken {
+private:
+    mutable std::atomic<bool> cancelled;
+    std::chrono::steady_clock::time_point deadline;
+    bool hasDeadline;
+    const CancellationToken* parent;
+
+public:
+    CancellationToken() : cancelled(false), hasDeadline(false), parent(nullptr) {
+    }
+
+    explicit CancellationToken(std::chrono::steady_clock::time_point deadline)
+        : cancelled(false), deadline(deadline), hasDeadline(true), parent(nullptr) {
+    }
+
+    CancellationToken(const CancellationToken* parent, std::chrono::steady_clock::time_point deadline,
+                      bool hasDeadline)
+        : cancelled(false), deadline(deadline), hasDeadline(hasDeadline), parent(parent) {
+    }
+
+    CancellationToken(const CancellationToken&) = delete;
+    CancellationToken& operator=(const CancellationToken&) = delete;
+
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+    bool isCancelled() const {
+        if (cancelled.load(std::memory_order_relaxed)) {
+            return true;
+        }
+        if ((hasDeadline && std::chrono::steady_clock::now() >= deadline) ||
+            (parent && parent->isCancelled())) {
+            cancelled.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    bool isPastDeadline() const {
+        return hasDeadline && std::chrono::steady_clock::now() >= deadline;
+    }
+};
+
+} // namespace graph_coloring
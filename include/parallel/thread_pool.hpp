@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "work_stealing_deque.hpp"
+
+namespace graph_coloring {
+
+class TaskGroup;
+
+// Fixed set of worker threads, each with its own work-stealing deque.
+// Tasks submitted from a worker go to that worker's deque (newest first);
+// tasks from other threads go to a shared injection queue. Idle workers
+// steal from the others. Threads waiting on a TaskGroup run that group's
+// pending tasks instead of blocking, so nested parallelism does not
+// deadlock, and never unrelated ones that could hold the wait up.
+class ThreadPool {
+private:
+    struct Task {
+        std::function<void()> function;
+        TaskGroup* group;
+    };
+
+    struct Worker {
+        WorkStealingDeque<Task*> deque;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex injectionMutex;
+    std::deque<Task*> injection;   // Tasks submitted from outside the pool
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queued;       // Tasks submitted but not yet taken
+    std::atomic<int> sleepers;
+    std::atomic<bool> stopping;
+    bool pinThreads;
+
+    void workerLoop(int index);
+    Task* findTask(int self, TaskGroup* group);
+    void execute(Task* task);
+    void pinCurrentThread(int index);
+
+public:
+    // threads <= 0 uses one worker per hardware thread
+    explicit ThreadPool(int threads = 0, bool pinThreads = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getThreadCount() const { return static_cast<int>(workers.size()); }
+
+    // Queue a task that is not part of a group; exceptions it throws are dropped
+    void submit(std::function<void()> function);
+    void submit(std::function<void()> function, TaskGroup* group);
+
+    // Run one pending task of group (any task if null) on the calling
+    // thread; false if none was found
+    bool runPendingTask(TaskGroup* group = nullptr);
+
+    // Index of the calling worker in its pool, -1 outside any pool
+    static int currentWorkerIndex();
+
+    // Process-wide pool used by the library, created on first use
+    static ThreadPool& global();
+    // Size and pinning of the global pool; must be called before its first use
+    static void configureGlobal(int threads, bool pinThreads);
+};
+
+// A set of tasks that can be waited for (and cancelled) together.
+// wait() rethrows the first exception thrown by a task.
+class TaskGroup {
+private:
+    ThreadPool& pool;
+    std::atomic<int> pending;
+    std::atomic<bool> cancelled;
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+
+    friend class ThreadPool;
+    void taskFinished(std::exception_ptr taskError);
+
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::global());
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> function);
+
+    // Block until every task has finished, running the group's pending tasks meanwhile
+    void wait();
+
+    // Tasks that have not started yet are skipped; running ones can poll isCancelled
+    void cancel();
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    ThreadPool& getPool() { return pool; }
+};
+
+// Call body(begin, end) on subranges of [begin, end) no longer than grain,
+// splitting the range recursively across the pool; returns when all are done
+void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body,
+                 ThreadPool& pool = ThreadPool::global());
+
+} // namespace graph_coloring
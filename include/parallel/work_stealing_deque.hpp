@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace graph_coloring {
+
+// Chase-Lev work-stealing deque (with the memory orderings of Le et al.,
+// "Correct and Efficient Work-Stealing for Weak Memory Models").
+// The owning thread pushes and pops at the bottom; any other thread may
+// steal from the top. T must be trivially copyable, e.g. a pointer.
+template <typename T>
+class WorkStealingDeque {
+private:
+    // Circular buffer; replaced by a larger copy when full
+    class Buffer {
+    private:
+        int64_t capacity;
+        std::unique_ptr<std::atomic<T>[]> items;
+
+    public:
+        explicit Buffer(int64_t capacity) : capacity(capacity), items(new std::atomic<T>[capacity]) {
+        }
+
+        int64_t getCapacity() const { return capacity; }
+        T get(int64_t index) const { return items[index & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t index, T item) { items[index & (capacity - 1)].store(item, std::memory_order_relaxed); }
+
+        Buffer* grow(int64_t bottom, int64_t top) const {
+            Buffer* larger = new Buffer(capacity * 2);
+            for (int64_t i = top; i < bottom; i++) {
+                larger->put(i, get(i));
+            }
+            return larger;
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> top;
+    alignas(64) std::atomic<int64_t> bottom;
+    std::atomic<Buffer*> buffer;
+    // Thieves may still read an old buffer, so replaced ones are kept until destruction
+    std::vector<std::unique_ptr<Buffer>> buffers;
+
+public:
+    explicit WorkStealingDeque(int64_t capacity = 256) : top(0), bottom(0) {
+        buffers.emplace_back(new Buffer(capacity));
+        buffer.store(buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only
+    void push(T item) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* current = buffer.load(std::memory_order_relaxed);
+        if (b - t > current->getCapacity() - 1) {
+            current = current->grow(b, t);
+            buffers.emplace_back(current);
+            buffer.store(current, std::memory_order_release);
+        }
+        current->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only; takes the most recently pushed item
+    bool pop(T& item) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* current = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        
+        if (t > b) {
+            // Empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        
+        item = current->get(b);
+        if (t == b) {
+            // Last item: race thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread; takes the oldest item
+    bool steal(T& item) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+        
+        Buffer* current = buffer.load(std::memory_order_acquire);
+        item = current->get(t);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+};
+
+} // namespace graph_coloring
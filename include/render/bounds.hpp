@@ -0,0 +1,27 @@
+#pragma once
+
+namespace graph_coloring {
+
+// Axis-aligned rectangle in layout coordinates
+struct Bounds {
+    float minX = 0.0f;
+    float minY = 0.0f;
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+
+    bool contains(float x, float y) const { return x >= minX && x <= maxX && y >= minY && y <= maxY; }
+    bool contains(const Bounds& other) const {
+        return other.minX >= minX && other.maxX <= maxX && other.minY >= minY && other.maxY <= maxY;
+    }
+    bool intersects(const Bounds& other) const {
+        return other.minX <= maxX && other.maxX >= minX && other.minY <= maxY && other.maxY >= minY;
+    }
+    // Squared distance from (x, y) to the rectangle; 0 inside
+    float distanceSquared(float x, float y) const {
+        float dx = minX - x > 0.0f ? minX - x : (x - maxX > 0.0f ? x - maxX : 0.0f);
+        float dy = minY - y > 0.0f ? minY - y : (y - maxY > 0.0f ? y - maxY : 0.0f);
+        return dx * dx + dy * dy;
+    }
+};
+
+} // namespace graph_coloring
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include "bounds.hpp"
+
+namespace graph_coloring {
+
+// View of the layout in a window: screen = layout * scale + offset, in pixels
+// with y pointing down. At zoom 1, centered, the layout's unit square fills
+// the window minus a margin on each side (the mapping the image renderers use).
+class Camera {
+private:
+    int width;
+    int height;
+    float margin;
+    float centerX; // Layout point at the middle of the window
+    float centerY;
+    float zoom;
+    unsigned long long version; // Bumped on every change
+
+public:
+    static constexpr float MIN_ZOOM = 0.05f;
+    static constexpr float MAX_ZOOM = 10000.0f;
+
+    Camera(int width, int height, float margin);
+
+    void setViewport(int width, int height);
+    // Back to zoom 1, showing the whole unit square
+    void reset();
+
+    // Move the view by a screen distance, e.g. a mouse drag
+    void pan(float dx, float dy);
+    // Multiply the zoom, keeping the layout point under (x, y) in place
+    void zoomAt(float x, float y, float factor);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    float getZoom() const { return zoom; }
+    float getScaleX() const { return std::max(width - 2 * margin, 1.0f) * zoom; }
+    float getScaleY() const { return std::max(height - 2 * margin, 1.0f) * zoom; }
+    float getOffsetX() const { return width * 0.5f - centerX * getScaleX(); }
+    float getOffsetY() const { return height * 0.5f - centerY * getScaleY(); }
+    unsigned long long getVersion() const { return version; }
+
+    float toScreenX(float x) const { return x * getScaleX() + getOffsetX(); }
+    float toScreenY(float y) const { return y * getScaleY() + getOffsetY(); }
+    float toLayoutX(float x) const { return (x - getOffsetX()) / getScaleX(); }
+    float toLayoutY(float y) const { return (y - getOffsetY()) / getScaleY(); }
+
+    // Layout area in the window, widened by pixels on every side
+    Bounds visibleArea(float pixels = 0.0f) const;
+};
+
+} // namespace graph_coloring
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+#include "../graph/graph.hpp"
+#include "camera.hpp"
+#include "palette.hpp"
+
+namespace graph_coloring {
+
+// Screen-space summary of a view too dense to draw item by item: an RGBA
+// image with one texel per cellSize x cellSize block of window pixels
+struct DensityImage {
+    int cellSize = 4;
+    int columns = 0;
+    int rows = 0;
+    std::vector<unsigned char> rgba; // Row-major, row 0 at the top of the window
+};
+
+// Vertices binned into cells: each cell takes the mean of its vertices'
+// palette colors (their color histogram), more opaque the more vertices it
+// holds. colors holds a palette index per dense vertex; subset (if given)
+// limits the vertices considered.
+void buildVertexCells(const Graph& graph, const std::vector<int>& colors, const Palette& palette,
+                      const Camera& camera, const std::vector<int>* subset, int cellSize, DensityImage& image);
+
+// Edges accumulated as line density: each edge is clipped to the window and
+// sampled once per cell it crosses; cells darken with the log of their count.
+// edgeEndpoints holds dense source, target pairs; runs on the thread pool.
+void buildEdgeDensity(const Graph& graph, const std::vector<int>& edgeEndpoints, const Camera& camera,
+                      const std::vector<int>* subset, int cellSize, DensityImage& image);
+
+} // namespace graph_coloring
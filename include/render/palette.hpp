@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+namespace graph_coloring {
+
+// RGB colors (0..1) for color classes 0..colorCount-1, shared by the viewer
+// and the image renderers, plus a last gray entry for uncolored vertices.
+// The colors are generated, not looked up, so any number of classes gets
+// distinct colors: class k steps its hue by the golden angle in OKLCh (a
+// perceptually uniform space) and cycles through three lightness levels.
+// A class has the same color in every palette; building one costs a few
+// operations per class, so renderers rebuild it only when the count changes.
+class Palette {
+private:
+    int colorCount;
+    std::vector<float> rgb; // 3 per entry, colorCount + 1 entries
+
+public:
+    explicit Palette(int colorCount = 0);
+
+    int getColorCount() const { return colorCount; }
+    int getSize() const { return colorCount + 1; }
+
+    // Entry for a vertex color; -1 (uncolored) and colors past the palette
+    // use the gray entry
+    int indexOf(int color) const { return color >= 0 && color < colorCount ? color : colorCount; }
+
+    const float* getColor(int index) const { return &rgb[3 * index]; }
+    const float* data() const { return rgb.data(); }
+};
+
+// RGB (0..1) of color class color
+void paletteColor(int color, float rgb[3]);
+
+} // namespace graph_coloring
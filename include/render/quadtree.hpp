@@ -0,0 +1,37 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace graph_coloring {
+
+// When a point quadtree splits a node into quadrants
+struct QuadtreeLimits {
+    // A node with at most this many points is not split further
+    int leafSize;
+    // Stops the split when many points share a position
+    int maxDepth;
+
+    bool splits(int count, int depth) const { return count > leafSize && depth < maxDepth; }
+};
+
+// Partitions order[begin, end) into quadrants around (midX, midY): by y, then
+// each half by x. Quadrant q holds order[cuts[q], cuts[q + 1]) and covers the
+// low or high half in x (q & 1) and in y (q & 2).
+template <typename GetX, typename GetY>
+void partitionQuadrants(std::vector<int>& order, int begin, int end, float midX, float midY,
+                        GetX getX, GetY getY, int cuts[5]) {
+    auto first = order.begin() + begin;
+    auto last = order.begin() + end;
+    auto lowX = [&](int v) { return getX(v) < midX; };
+    auto ySplit = std::partition(first, last, [&](int v) { return getY(v) < midY; });
+    auto lowYSplit = std::partition(first, ySplit, lowX);
+    auto highYSplit = std::partition(ySplit, last, lowX);
+    cuts[0] = begin;
+    cuts[1] = static_cast<int>(lowYSplit - order.begin());
+    cuts[2] = static_cast<int>(ySplit - order.begin());
+    cuts[3] = static_cast<int>(highYSplit - order.begin());
+    cuts[4] = end;
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "../graph/graph.hpp"
+#include "palette.hpp"
+
+namespace graph_coloring {
+
+// How a colored graph is drawn into an image
+struct ImageStyle {
+    int width = 1024;            // Full image size in pixels
+    int height = 1024;
+    float vertexRadius = 4.0f;   // Pixels; circles stay inside the image like in the viewer
+    float outlineWidth = 1.0f;   // Black ring around each vertex; 0 = none
+    float edgeWidth = 1.0f;      // Pixels; 0 = don't draw edges
+    float edgeOpacity = 1.0f;    // Black edges blended at this opacity
+    unsigned char background[3] = {255, 255, 255};
+};
+
+// RGB pixels of a rectangle of the full image starting at (originX, originY);
+// the whole image is a single region at (0, 0)
+class RasterImage {
+private:
+    int originX;
+    int originY;
+    int width;
+    int height;
+    std::vector<unsigned char> pixels; // Row-major RGB
+
+public:
+    RasterImage(int originX, int originY, int width, int height);
+
+    int getOriginX() const { return originX; }
+    int getOriginY() const { return originY; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const unsigned char* getPixels() const { return pixels.data(); }
+    unsigned char* getPixels() { return pixels.data(); }
+
+    void fill(const unsigned char rgb[3]);
+
+    // Mix rgb (0..1) into the pixel at full-image coordinates (x, y) with
+    // the given coverage; pixels outside the region are ignored
+    void blend(int x, int y, const float rgb[3], float coverage);
+};
+
+// A colored graph projected into image coordinates once, so any number of
+// regions can be rasterized from it, concurrently if needed (renderRegion is
+// const). Edges are antialiased, vertices are antialiased disks.
+class GraphRaster {
+private:
+    ImageStyle style;
+    std::vector<float> positions; // x, y in image pixels per dense vertex index
+    Palette palette;              // Covers every color in the graph
+    std::vector<int> colors;      // Palette index per dense vertex index
+    std::vector<int> edges;       // Dense source, target per edge
+
+    void drawEdge(RasterImage& region, int edge) const;
+    void drawVertex(RasterImage& region, int vertex) const;
+
+    // Vertical reach of an edge / vertex beyond its endpoints / center, in pixels
+    float edgeReach() const { return style.edgeWidth * 0.5f + 1.0f; }
+    float vertexReach() const { return style.vertexRadius + 1.0f; }
+    // Higher endpoint of an edge (smallest y)
+    float edgeTop(int edge) const {
+        return std::min(positions[2 * edges[2 * edge] + 1], positions[2 * edges[2 * edge + 1] + 1]);
+    }
+
+public:
+    // Progress of binBand down the image: edges and vertices sorted by the
+    // top of their extent once, and the ones reached so far that may still
+    // reach the next band
+    struct BandSweep {
+        std::vector<int> edgeOrder;
+        std::vector<int> vertexOrder;
+        size_t nextEdge = 0;
+        size_t nextVertex = 0;
+        std::vector<int> activeEdges;
+        std::vector<int> activeVertices;
+    };
+
+    GraphRaster(const Graph& graph, const ImageStyle& style);
+
+    const ImageStyle& getStyle() const { return style; }
+    int getVertexCount() const { return static_cast<int>(colors.size()); }
+    int getEdgeCount() const { return static_cast<int>(edges.size() / 2); }
+
+    // Clear the region to the background and draw the edges, then the vertices
+    void renderRegion(RasterImage& region) const;
+
+    // Same, but only the listed edges and vertices (e.g. those binned to a tile)
+    void renderRegion(RasterImage& region, const std::vector<int>& edgeList, const std::vector<int>& vertexList) const;
+
+    // Start binning bands from the top of the image
+    BandSweep startSweep() const;
+
+    // Bin the edges and vertices that reach image rows [top, bottom) by the
+    // tileSize-wide columns they touch; bins are resized to the column count.
+    // Bands must come top to bottom through the same sweep, which only looks
+    // at the primitives reaching each band rather than at all of them.
+    void binBand(int top, int bottom, int tileSize, BandSweep& sweep, std::vector<std::vector<int>>& edgeBins,
+                 std::vector<std::vector<int>>& vertexBins) const;
+};
+
+enum class ImageFormat {
+    Png,      // Whole image in memory, written with stb_image_write
+    TiledTiff // Rendered and streamed tile by tile; see tiled_image.hpp
+};
+
+// Parse "png" or "tiff"; false if the name is unknown
+bool parseImageFormat(const std::string& name, ImageFormat& format);
+const char* imageFormatExtension(ImageFormat format);
+
+// Rasterize the whole graph and write it as a PNG; throws std::runtime_error on failure
+void writeGraphPng(const Graph& graph, const ImageStyle& style, const std::string& path);
+
+// writeGraphPng or writeGraphTiff
+void writeGraphImage(const Graph& graph, const ImageStyle& style, ImageFormat format, const std::string& path);
+
+} // namespace graph_coloring
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include "../graph/graph.hpp"
+#include "bounds.hpp"
+
+namespace graph_coloring {
+
+// Quadtree over the vertex positions and edge bounding boxes of a graph, for
+// viewport culling and picking. Vertices are split until a leaf holds a few
+// of them, and each subtree's vertices are stored contiguously, so a node
+// that lies entirely inside a query is answered without visiting its
+// children. Each edge sits in the smallest node that contains its bounding
+// box. Vertices and edges are numbered like Graph::getEdgeEndpoints numbers
+// them: dense vertex index, and position among the edges whose endpoints
+// exist.
+class SpatialIndex {
+private:
+    struct Node {
+        Bounds bounds;
+        int firstChild;  // Four consecutive children, or -1 for a leaf
+        int vertexBegin; // Range in vertexOrder for the whole subtree
+        int vertexEnd;
+        int edgeBegin;   // Range in edgeOrder for edges held by this node
+        int edgeEnd;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<float> positions; // x, y per vertex
+    std::vector<int> vertexOrder; // Vertex indices grouped by subtree
+    std::vector<int> edgeOrder;   // Edge indices grouped by node
+    std::vector<Bounds> edgeBounds;
+
+    void split(int node, int depth);
+    int edgeNode(const Bounds& box) const;
+
+public:
+    SpatialIndex() = default;
+
+    // Index the current layout; call again after vertices move.
+    // edgeEndpoints is the graph's Graph::getEdgeEndpoints().
+    void build(const Graph& graph, const std::vector<int>& edgeEndpoints);
+    void clear();
+
+    bool isEmpty() const { return nodes.empty(); }
+    // Bounding box of all vertices
+    Bounds getBounds() const { return nodes.empty() ? Bounds() : nodes[0].bounds; }
+
+    // Append the vertices inside area to result
+    void queryVertices(const Bounds& area, std::vector<int>& result) const;
+    // Append the edges whose bounding box meets area to result
+    void queryEdges(const Bounds& area, std::vector<int>& result) const;
+
+    // Vertex closest to (x, y) within maxDistance, or -1
+    int nearestVertex(float x, float y, float maxDistance) const;
+};
+
+} // namespace graph_coloring
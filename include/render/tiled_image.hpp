@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "rasterizer.hpp"
+
+namespace graph_coloring {
+
+// Writes an uncompressed RGB tiled TIFF one tile at a time, so an image far
+// larger than memory can be produced. Tiles may arrive in any order; the
+// directory with their offsets is written by finish(). Files that could pass
+// 4 GiB are written as BigTIFF.
+class TiledTiffWriter {
+private:
+    std::string path;
+    std::ofstream out;
+    int width;
+    int height;
+    int tileSize;
+    int columns;
+    int rows;
+    bool bigTiff;
+    std::vector<uint64_t> tileOffsets; // 0 = not written yet
+    uint64_t position;                 // Bytes written so far
+
+    void writeBytes(const void* data, size_t size);
+
+public:
+    // tileSize must be a multiple of 16 (a TIFF requirement)
+    TiledTiffWriter(const std::string& path, int width, int height, int tileSize);
+
+    TiledTiffWriter(const TiledTiffWriter&) = delete;
+    TiledTiffWriter& operator=(const TiledTiffWriter&) = delete;
+
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+    bool isBigTiff() const { return bigTiff; }
+
+    // tile must be tileSize x tileSize; pixels past the image edge are padding
+    void writeTile(int column, int row, const RasterImage& tile);
+
+    // Write the image directory; throws if a tile is missing or the disk is full
+    void finish();
+};
+
+// Render the graph in tileSize x tileSize tiles on the global thread pool and
+// stream them to a tiled TIFF. Only one row of tiles is held in memory.
+void writeGraphTiff(const Graph& graph, const ImageStyle& style, const std::string& path, int tileSize = 256);
+
+} // namespace graph_coloring
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Lightweight tracing: scoped zones recorded into per-thread ring buffers and
+// dumped as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+//
+// Zones are only compiled in when GRAPHCOLORING_TRACING is defined (CMake
+// option GRAPHCOLORING_ENABLE_TRACING); otherwise GC_TRACE_SCOPE expands to
+// nothing. When compiled in, recording is still off until Tracer::setEnabled.
+
+namespace graph_coloring {
+
+class Tracer {
+public:
+    // Events kept per thread before the oldest are overwritten
+    static const size_t BUFFER_CAPACITY = 1 << 16;
+    
+    // True when zones were compiled in
+    static bool isCompiledIn();
+    
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    
+    // Label the calling thread in the trace viewer
+    static void setThreadName(const std::string& name);
+    
+    // Record a completed zone; name must outlive the tracer (string literal)
+    static void record(const char* name, uint64_t startNs, uint64_t endNs);
+    
+    // Nanoseconds since the tracer epoch
+    static uint64_t now();
+    
+    // Write all recorded events as Chrome trace JSON. Call once traced work has
+    // finished; events recorded concurrently with the dump may be torn.
+    static bool writeChromeTrace(const std::string& path);
+    
+    // Drop all recorded events
+    static void clear();
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+// For the executables' --trace option: start recording on the calling
+// (main) thread if a trace file was requested, warning when tracing is not
+// compiled in, and write the file at exit. Empty paths do nothing.
+void startTracing(const std::string& tracePath);
+void finishTracing(const std::string& tracePath);
+
+// RAII zone: records [construction, destruction) under the given name
+class TraceScope {
+private:
+    const char* name;
+    uint64_t startNs;
+
+public:
+    explicit TraceScope(const char* name)
+        : name(Tracer::isEnabled() ? name : nullptr), startNs(this->name ? Tracer::now() : 0) {
+    }
+    ~TraceScope() {
+        if (name) {
+            Tracer::record(name, startNs, Tracer::now());
+        }
+    }
+    
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+} // namespace graph_coloring
+
+#define GC_TRACE_CONCAT_INNER(a, b) a##b
+#define GC_TRACE_CONCAT(a, b) GC_TRACE_CONCAT_INNER(a, b)
+
+#ifdef GRAPHCOLORING_TRACING
+#define GC_TRACE_SCOPE(name) ::graph_coloring::TraceScope GC_TRACE_CONCAT(gcTraceScope, __LINE__)(name)
+#else
+#define GC_TRACE_SCOPE(name) ((void)0)
+#endif
@@ -0,0 +1,319 @@
+#include "../../include/batch/batch_runner.hpp"
+#include "../../include/io/csv.hpp"
+#include "../../include/io/graph_io.hpp"
+#include "../../include/parallel/thread_pool.hpp"
+#include "../../include/trace/trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+namespace graph_coloring {
+
+namespace {
+
+// Match a file name against a pattern containing '*' and '?' wildcards
+bool wildcardMatch(const std::string& pattern, const std::string& name) {
+    size_t p = 0;
+    size_t n = 0;
+    size_t starPos = std::string::npos;
+    size_t starMatch = 0;
+    
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            p++;
+            n++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            starPos = p++;
+            starMatch = n;
+        } else if (starPos != std::string::npos) {
+            p = starPos + 1;
+            n = ++starMatch;
+        } else {
+            return false;
+        }
+    }
+    
+    while (p < pattern.size() && pattern[p] == '*') {
+        p++;
+    }
+    return p == pattern.size();
+}
+
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+// dir/name + extension, creating the directories name adds below dir
+std::string outputPath(const std::string& dir, const std::string& name, const std::string& extension) {
+    std::filesystem::path path = std::filesystem::path(dir) / (name + extension);
+    std::filesystem::create_directories(path.parent_path());
+    return path.string();
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+    return duration.count();
+}
+
+} // namespace
+
+BatchRunner::BatchRunner(const BatchOptions& options) : options(options) {
+}
+
+BatchRunner::~BatchRunner() {
+}
+
+std::vector<std::string> BatchRunner::expandInputs(const std::vector<std::string>& patterns) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> paths;
+    
+    for (const auto& pattern : patterns) {
+        // "@file" reads one path or pattern per line
+        if (!pattern.empty() && pattern[0] == '@') {
+            std::ifstream list(pattern.substr(1));
+            if (!list) {
+                throw std::runtime_error("Cannot open input list: " + pattern.substr(1));
+            }
+            std::vector<std::string> listed;
+            std::string line;
+            while (std::getline(list, line)) {
+                if (!line.empty() && line[0] != '#') {
+                    listed.push_back(line);
+                }
+            }
+            std::vector<std::string> expanded = expandInputs(listed);
+            paths.insert(paths.end(), expanded.begin(), expanded.end());
+            continue;
+        }
+        
+        if (pattern.find_first_of("*?") == std::string::npos) {
+            paths.push_back(pattern);
+            continue;
+        }
+        
+        // Only the file name part may contain wildcards
+        fs::path patternPath(pattern);
+        fs::path directory = patternPath.has_parent_path() ? patternPath.parent_path() : fs::path(".");
+        std::string namePattern = patternPath.filename().string();
+        
+        std::vector<std::string> matches;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(directory, ec)) {
+            if (entry.is_regular_file() && wildcardMatch(namePattern, entry.path().filename().string())) {
+                matches.push_back(entry.path().string());
+            }
+        }
+        std::sort(matches.begin(), matches.end());
+        paths.insert(paths.end(), matches.begin(), matches.end());
+    }
+    
+    return paths;
+}
+
+std::vector<std::string> BatchRunner::outputNames(const std::vector<std::string>& paths) {
+    namespace fs = std::filesystem;
+    std::vector<fs::path> absolute;
+    absolute.reserve(paths.size());
+    for (const auto& path : paths) {
+        absolute.push_back(fs::absolute(path).lexically_normal());
+    }
+    
+    // Deepest directory containing every input
+    fs::path root;
+    for (size_t i = 0; i < absolute.size(); i++) {
+        fs::path directory = absolute[i].parent_path();
+        if (i == 0) {
+            root = directory;
+            continue;
+        }
+        fs::path common;
+        auto a = root.begin();
+        auto b = directory.begin();
+        for (; a != root.end() && b != directory.end() && *a == *b; ++a, ++b) {
+            common /= *a;
+        }
+        root = common;
+    }
+    
+    std::vector<std::string> names;
+    names.reserve(paths.size());
+    std::unordered_set<std::string> seen;
+    for (size_t i = 0; i < absolute.size(); i++) {
+        // Inputs on different drives share no root; keep their full path then
+        fs::path relative = root.empty() ? absolute[i].relative_path() : absolute[i].lexically_relative(root);
+        std::string name = relative.generic_string();
+        // The same file listed twice still gets two outputs
+        if (!seen.insert(name).second) {
+            name += "." + std::to_string(i);
+            seen.insert(name);
+        }
+        names.push_back(name);
+    }
+    return names;
+}
+
+std::vector<BatchResult> BatchRunner::run() {
+    std::vector<std::string> paths = expandInputs(options.inputs);
+    std::vector<std::string> names = outputNames(paths);
+    std::vector<BatchResult> results(paths.size());
+    
+    if (!options.checkpointDir.empty()) {
+        std::filesystem::create_directories(options.checkpointDir);
+    }
+    if (!options.imageDir.empty()) {
+        std::filesystem::create_directories(options.imageDir);
+    }
+    if (!options.outputDir.empty()) {
+        std::filesystem::create_directories(options.outputDir);
+        if (options.asyncWrite) {
+            asyncWriter = std::make_unique<AsyncResultWriter>();
+        }
+    }
+    
+    ThreadPool& pool = ThreadPool::global();
+    int taskCount = options.threads;
+    if (taskCount <= 0) {
+        taskCount = pool.getThreadCount();
+    }
+    taskCount = std::min<int>(taskCount, std::max<size_t>(paths.size(), 1));
+    
+    // One pool task per file, at most taskCount at a time: each finished file
+    // queues the next one. The calling thread helps while it waits.
+    std::atomic<size_t> nextIndex(0);
+    TaskGroup group(pool);
+    std::function<void()> processNext = [&]() {
+        size_t i = nextIndex++;
+        if (i >= paths.size()) {
+            return;
+        }
+        {
+            GC_TRACE_SCOPE("batch task");
+            // Once the run is cancelled (e.g. the node is preempted) the remaining files are skipped
+            if (options.solve.cancellation && options.solve.cancellation->isCancelled()) {
+                results[i].path = paths[i];
+                results[i].error = "cancelled";
+            } else {
+                results[i] = processFile(i, paths[i], names[i]);
+            }
+        }
+        if (nextIndex.load() < paths.size()) {
+            group.run(processNext);
+        }
+    };
+    
+    for (int i = 0; i < taskCount; i++) {
+        group.run(processNext);
+    }
+    group.wait();
+    
+    // Wait for background writes; a failed write fails its file, as it
+    // would have written synchronously
+    if (asyncWriter) {
+        std::unique_ptr<AsyncResultWriter> writer = std::move(asyncWriter);
+        for (const auto& failure : writer->flush()) {
+            results[failure.id].ok = false;
+            results[failure.id].error = failure.message;
+        }
+    }
+    
+    return results;
+}
+
+BatchResult BatchRunner::processFile(size_t index, const std::string& path, const std::string& name) const {
+    BatchResult result;
+    result.path = path;
+    
+    try {
+        auto loadStart = std::chrono::steady_clock::now();
+        Graph graph;
+        {
+            GC_TRACE_SCOPE("load graph");
+            graph = GraphLoader::loadFromFile(path);
+        }
+        result.loadMs = elapsedMs(loadStart);
+        
+        graph.setVerbose(false);
+        SolveOptions solve = options.solve;
+        if (!options.checkpointDir.empty()) {
+            solve.checkpointPath = outputPath(options.checkpointDir, name, ".ckpt");
+        }
+        if (options.progress) {
+            solve.progress = [this, &path](const SolveProgress& progress) { options.progress(path, progress); };
+        }
+        auto colorStart = std::chrono::steady_clock::now();
+        graph.colorGraph(options.algorithm, solve);
+        result.colorMs = elapsedMs(colorStart);
+        
+        result.vertexCount = graph.getVertexCount();
+        result.edgeCount = graph.getEdgeCount();
+        result.colorCount = graph.getNumberOfColors();
+        result.stats = graph.getLastStats();
+        result.valid = options.validate ? graph.isValidColoring() : true;
+        
+        if (!options.outputDir.empty()) {
+            GC_TRACE_SCOPE("write coloring");
+            writeColoring(index, name, graph);
+        }
+        if (!options.imageDir.empty()) {
+            if (options.layout != LayoutAlgorithm::Circular) {
+                layoutGraph(graph, options.layout);
+            }
+            writeGraphImage(graph, options.imageStyle, options.imageFormat,
+                            outputPath(options.imageDir, name, imageFormatExtension(options.imageFormat)));
+        }
+        result.ok = true;
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    
+    return result;
+}
+
+void BatchRunner::writeColoring(size_t index, const std::string& name, Graph& graph) const {
+    std::string path = outputPath(options.outputDir, name, ResultWriter::extension(options.outputFormat));
+    
+    if (asyncWriter) {
+        asyncWriter->submit(index, path, ColoringRecord::fromGraph(graph), options.outputFormat);
+    } else {
+        ResultWriter::writeFile(path, ColoringRecord::fromGraph(graph), options.outputFormat);
+    }
+}
+
+void BatchRunner::writeSummary(std::ostream& out, const std::vector<BatchResult>& results) {
+    out << "file,status,vertices,edges,colors,valid,solve_status,load_ms,color_ms,error\n";
+    for (const auto& result : results) {
+        out << csvField(result.path) << ','
+            << (result.ok ? "ok" : "failed") << ','
+            << result.vertexCount << ','
+            << result.edgeCount << ','
+            << result.colorCount << ','
+            << (result.valid ? "yes" : "no") << ','
+            << result.stats.status << ','
+            << result.loadMs << ','
+            << result.colorMs << ','
+            << csvField(result.error) << '\n';
+    }
+}
+
+void BatchRunner::writeStats(std::ostream& out, const std::vector<BatchResult>& results) {
+    for (const auto& result : results) {
+        if (result.ok) {
+            out << "{\"file\": " << jsonString(result.path) << ", \"stats\": " << result.stats.toJson() << "}\n";
+        }
+    }
+}
+
+} // namespace graph_coloring
\ No newline at end of file
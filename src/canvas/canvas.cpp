@@ -1,4 +1,6 @@
 #include "../../include/canvas/canvas.hpp"
+#include "../../include/trace/trace.hpp"
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
@@ -8,26 +10,38 @@
 
 namespace graph_coloring {
 
+namespace {
+
+// Level of detail: vertices turn into cells once their circles would cover
+// more than this fraction of the window, edges turn into a density image
+// once there are more than one per this many pixels. Views with fewer items
+// than LOD_MIN_ITEMS are always drawn item by item.
+const float VERTEX_COVERAGE_LIMIT = 0.5f;
+const int PIXELS_PER_EDGE_LIMIT = 16;
+const size_t LOD_MIN_ITEMS = 20000;
+const int LOD_CELL_SIZE = 4;
+
+// Zoom step per mouse wheel notch; a press that moves less than this many
+// pixels before release is a click rather than a drag
+const double ZOOM_STEP = 1.2;
+const double DRAG_THRESHOLD = 3.0;
+
+} // namespace
+
 // GLFW error callback
 static void glfw_error_callback(int error, const char* description) {
     std::cerr << "GLFW Error " << error << ": " << description << std::endl;
 }
 
-// Define predefined colors for graph coloring
 Canvas::Canvas(int width, int height, const std::string& title)
-    : width(width), height(height), title(title), graph(nullptr), window(nullptr) {
-    
-    // Initialize predefined colors (RGB format, values from 0 to 1)
-    colors[0][0] = 1.0f; colors[0][1] = 0.0f; colors[0][2] = 0.0f; // Red
-    colors[1][0] = 0.0f; colors[1][1] = 0.0f; colors[1][2] = 1.0f; // Blue
-    colors[2][0] = 0.0f; colors[2][1] = 0.8f; colors[2][2] = 0.0f; // Green
-    colors[3][0] = 1.0f; colors[3][1] = 1.0f; colors[3][2] = 0.0f; // Yellow
-    colors[4][0] = 1.0f; colors[4][1] = 0.5f; colors[4][2] = 0.0f; // Orange
-    colors[5][0] = 0.5f; colors[5][1] = 0.0f; colors[5][2] = 0.5f; // Purple
-    colors[6][0] = 0.0f; colors[6][1] = 1.0f; colors[6][2] = 1.0f; // Cyan
-    colors[7][0] = 1.0f; colors[7][1] = 0.0f; colors[7][2] = 1.0f; // Magenta
-    colors[8][0] = 0.5f; colors[8][1] = 0.5f; colors[8][2] = 0.5f; // Gray
-    colors[9][0] = 0.0f; colors[9][1] = 0.5f; colors[9][2] = 0.0f; // Dark Green
+    : window(nullptr), width(width), height(height), title(title), graph(nullptr),
+      camera(width, height, VERTEX_RADIUS), dragging(false), dragged(false), dragX(0.0), dragY(0.0),
+      endpointStructureVersion(0),
+      projectedStructureVersion(0), projectedPositionVersion(0), projectedCameraVersion(0),
+      paletteStructureVersion(0), paletteColorVersion(0),
+      indexedStructureVersion(0), indexedPositionVersion(0),
+      dirty(true), projectionDirty(true), animating(false),
+      drawnStructureVersion(0), drawnPositionVersion(0), drawnColorVersion(0) {
 }
 
 Canvas::~Canvas() {
@@ -55,71 +69,390 @@ bool Canvas::initialize() {
     // Make the window's context current
     glfwMakeContextCurrent(window);
     
+    // Follow window resizes; the callbacks find this canvas through the user pointer
+    glfwSetWindowUserPointer(window, this);
+    glfwSetWindowSizeCallback(window, windowSizeCallback);
+    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+    glfwSetWindowRefreshCallback(window, windowRefreshCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetCursorPosCallback(window, cursorPosCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+    
+    // Swaps wait for vsync, which paces animation to the display
+    glfwSwapInterval(1);
+    
+    // Load the OpenGL functions for this context
+    if (!gladLoadGL(glfwGetProcAddress)) {
+        std::cerr << "Failed to load OpenGL functions" << std::endl;
+        close();
+        return false;
+    }
+    
+    if (!renderer.initialize()) {
+        std::cerr << "OpenGL 3.3 is not available; falling back to immediate mode rendering" << std::endl;
+    }
+    
     return true;
 }
 
 void Canvas::setGraph(Graph* graph) {
     this->graph = graph;
+    endpointStructureVersion = 0;
+    projectedStructureVersion = 0;
+    paletteStructureVersion = 0;
+    indexedStructureVersion = 0;
+    dirty = true;
+}
+
+void Canvas::windowSizeCallback(GLFWwindow* window, int width, int height) {
+    Canvas* canvas = static_cast<Canvas*>(glfwGetWindowUserPointer(window));
+    canvas->width = width;
+    canvas->height = height;
+    canvas->camera.setViewport(width, height);
+    canvas->dirty = true;
+    canvas->projectionDirty = true;
+}
+
+void Canvas::framebufferSizeCallback(GLFWwindow* window, int width, int height) {
+    glViewport(0, 0, width, height);
+    static_cast<Canvas*>(glfwGetWindowUserPointer(window))->dirty = true;
+}
+
+void Canvas::windowRefreshCallback(GLFWwindow* window) {
+    // The window system lost the contents, e.g. after being uncovered
+    static_cast<Canvas*>(glfwGetWindowUserPointer(window))->dirty = true;
+}
+
+void Canvas::mouseButtonCallback(GLFWwindow* window, int button, int action, int /*mods*/) {
+    if (button != GLFW_MOUSE_BUTTON_LEFT) {
+        return;
+    }
+    
+    Canvas* canvas = static_cast<Canvas*>(glfwGetWindowUserPointer(window));
+    double x, y;
+    glfwGetCursorPos(window, &x, &y);
+    if (action == GLFW_PRESS) {
+        canvas->dragging = true;
+        canvas->dragged = false;
+        canvas->dragX = x;
+        canvas->dragY = y;
+        return;
+    }
+    
+    // A release without a drag is a click: report the clicked vertex
+    canvas->dragging = false;
+    if (!canvas->dragged && canvas->graph) {
+        int id = canvas->pickVertex(x, y);
+        if (id >= 0) {
+            std::cout << "Vertex " << id << ": color " << canvas->graph->getVertexColor(id) << std::endl;
+        }
+    }
+}
+
+void Canvas::cursorPosCallback(GLFWwindow* window, double x, double y) {
+    Canvas* canvas = static_cast<Canvas*>(glfwGetWindowUserPointer(window));
+    if (!canvas->dragging) {
+        return;
+    }
+    
+    double dx = x - canvas->dragX;
+    double dy = y - canvas->dragY;
+    if (!canvas->dragged && dx * dx + dy * dy < DRAG_THRESHOLD * DRAG_THRESHOLD) {
+        return;
+    }
+    canvas->dragged = true;
+    canvas->camera.pan(static_cast<float>(dx), static_cast<float>(dy));
+    canvas->dragX = x;
+    canvas->dragY = y;
+    canvas->dirty = true;
+}
+
+void Canvas::scrollCallback(GLFWwindow* window, double /*xOffset*/, double yOffset) {
+    Canvas* canvas = static_cast<Canvas*>(glfwGetWindowUserPointer(window));
+    double x, y;
+    glfwGetCursorPos(window, &x, &y);
+    canvas->camera.zoomAt(static_cast<float>(x), static_cast<float>(y),
+                          static_cast<float>(std::pow(ZOOM_STEP, yOffset)));
+    canvas->dirty = true;
+}
+
+bool Canvas::needsRedraw() const {
+    return dirty || animating ||
+           graph->getStructureVersion() != drawnStructureVersion ||
+           graph->getPositionVersion() != drawnPositionVersion ||
+           graph->getColorVersion() != drawnColorVersion;
+}
+
+void Canvas::updateEdgeEndpoints() {
+    if (graph->getStructureVersion() == endpointStructureVersion) {
+        return;
+    }
+    
+    edgeEndpoints = graph->getEdgeEndpoints();
+    endpointStructureVersion = graph->getStructureVersion();
+}
+
+void Canvas::updateProjection() {
+    if (graph->getStructureVersion() == projectedStructureVersion &&
+        graph->getPositionVersion() == projectedPositionVersion &&
+        camera.getVersion() == projectedCameraVersion) {
+        return;
+    }
+    
+    GC_TRACE_SCOPE("project vertices");
+    
+    // Map layout coordinates into the window through the camera
+    const std::vector<Vertex>& vertices = graph->getVertices();
+    screenPositions.resize(vertices.size() * 2);
+    for (size_t i = 0; i < vertices.size(); i++) {
+        screenPositions[2 * i] = camera.toScreenX(vertices[i].getX());
+        screenPositions[2 * i + 1] = camera.toScreenY(vertices[i].getY());
+    }
+    
+    projectedStructureVersion = graph->getStructureVersion();
+    projectedPositionVersion = graph->getPositionVersion();
+    projectedCameraVersion = camera.getVersion();
 }
 
-void Canvas::render() {
-    if (!window || !graph) {
+void Canvas::updatePalette() {
+    if (graph->getStructureVersion() == paletteStructureVersion &&
+        graph->getColorVersion() == paletteColorVersion) {
         return;
     }
     
+    const std::vector<Vertex>& vertices = graph->getVertices();
+    paletteIndices.resize(vertices.size());
+    int colorCount = 0;
+    for (size_t i = 0; i < vertices.size(); i++) {
+        paletteIndices[i] = graph->getVertexColor(vertices[i].getId());
+        colorCount = std::max(colorCount, paletteIndices[i] + 1);
+    }
+    if (colorCount != palette.getColorCount()) {
+        palette = Palette(colorCount);
+    }
+    for (int& index : paletteIndices) {
+        index = palette.indexOf(index);
+    }
+    paletteStructureVersion = graph->getStructureVersion();
+    paletteColorVersion = graph->getColorVersion();
+}
+
+void Canvas::updateSpatialIndex() {
+    if (graph->getStructureVersion() == indexedStructureVersion &&
+        graph->getPositionVersion() == indexedPositionVersion) {
+        return;
+    }
+    
+    updateEdgeEndpoints();
+    spatialIndex.build(*graph, edgeEndpoints);
+    indexedStructureVersion = graph->getStructureVersion();
+    indexedPositionVersion = graph->getPositionVersion();
+}
+
+float Canvas::vertexRadius() const {
+    return std::clamp(VERTEX_RADIUS * camera.getZoom(), MIN_VERTEX_RADIUS, MAX_VERTEX_RADIUS);
+}
+
+bool Canvas::cullToViewport(float radius) {
+    // Layouts are normalized to the unit square; when all of it is in view
+    // there is nothing to cull and the index isn't needed
+    Bounds area = camera.visibleArea(radius);
+    if (area.contains(Bounds{0.0f, 0.0f, 1.0f, 1.0f})) {
+        return false;
+    }
+    
+    updateSpatialIndex();
+    if (area.contains(spatialIndex.getBounds())) {
+        return false;
+    }
+    
+    GC_TRACE_SCOPE("cull");
+    visibleVertices.clear();
+    visibleEdges.clear();
+    spatialIndex.queryVertices(area, visibleVertices);
+    spatialIndex.queryEdges(area, visibleEdges);
+    return true;
+}
+
+int Canvas::pickVertex(double x, double y) {
+    if (!graph || graph->getVertices().empty()) {
+        return -1;
+    }
+    updateSpatialIndex();
+    
+    // Nearest vertex in layout coordinates, then check it is under the cursor on screen
+    float radius = vertexRadius();
+    float scaleX = camera.getScaleX();
+    float scaleY = camera.getScaleY();
+    float layoutX = camera.toLayoutX(static_cast<float>(x));
+    float layoutY = camera.toLayoutY(static_cast<float>(y));
+    int index = spatialIndex.nearestVertex(layoutX, layoutY, radius / std::min(scaleX, scaleY));
+    if (index < 0) {
+        return -1;
+    }
+    
+    const Vertex& vertex = graph->getVertices()[index];
+    float dx = (vertex.getX() - layoutX) * scaleX;
+    float dy = (vertex.getY() - layoutY) * scaleY;
+    return dx * dx + dy * dy <= radius * radius ? vertex.getId() : -1;
+}
+
+Camera& Canvas::getCamera() {
+    return camera;
+}
+
+bool Canvas::render() {
+    if (!window || !graph || !needsRedraw()) {
+        return false;
+    }
+    
+    GC_TRACE_SCOPE("Canvas::render");
+    dirty = false;
+    drawnStructureVersion = graph->getStructureVersion();
+    drawnPositionVersion = graph->getPositionVersion();
+    drawnColorVersion = graph->getColorVersion();
+    
     // Set clear color to white
     glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
     
     // Clear the screen
     glClear(GL_COLOR_BUFFER_BIT);
     
-    // Reset transformation matrix
-    glLoadIdentity();
-    
-    // Set up orthographic projection
-    glOrtho(0, width, height, 0, -1, 1);
+    // Only what is in view is drawn once part of the layout is off screen
+    float radius = vertexRadius();
+    const std::vector<int>* vertexSubset = nullptr;
+    const std::vector<int>* edgeSubset = nullptr;
+    if (cullToViewport(radius)) {
+        vertexSubset = &visibleVertices;
+        edgeSubset = &visibleEdges;
+    }
     
-    // Render edges first
-    for (const auto& edge : graph->getEdges()) {
-        renderEdge(edge);
+    // Too many items in view to draw one by one: draw density images instead
+    updateEdgeEndpoints();
+    updatePalette();
+    size_t shownVertices = vertexSubset ? vertexSubset->size() : graph->getVertices().size();
+    size_t shownEdges = edgeSubset ? edgeSubset->size() : edgeEndpoints.size() / 2;
+    float windowArea = static_cast<float>(width) * height;
+    bool vertexLod = shownVertices > LOD_MIN_ITEMS &&
+                     shownVertices * M_PI * radius * radius > VERTEX_COVERAGE_LIMIT * windowArea;
+    bool edgeLod = shownEdges > LOD_MIN_ITEMS && shownEdges * PIXELS_PER_EDGE_LIMIT > windowArea;
+    if (edgeLod) {
+        buildEdgeDensity(*graph, edgeEndpoints, camera, edgeSubset, LOD_CELL_SIZE, edgeDensity);
+    }
+    if (vertexLod) {
+        buildVertexCells(*graph, paletteIndices, palette, camera, vertexSubset, LOD_CELL_SIZE, vertexCells);
     }
     
-    // Then render vertices
-    for (const auto& vertex : graph->getVertices()) {
-        renderVertex(vertex);
+    if (renderer.isReady()) {
+        // Edges, then vertices, each in a single draw call from GPU buffers
+        if (edgeLod) {
+            renderer.drawImage(edgeDensity, camera);
+        } else {
+            renderer.drawEdges(*graph, edgeEndpoints, camera, edgeSubset);
+        }
+        if (vertexLod) {
+            renderer.drawImage(vertexCells, camera);
+        } else {
+            renderer.drawVertices(*graph, camera, radius, palette, vertexSubset);
+        }
+    } else {
+        updateProjection();
+        
+        // Orthographic projection in window coordinates; only set again after a resize
+        if (projectionDirty) {
+            glMatrixMode(GL_PROJECTION);
+            glLoadIdentity();
+            glOrtho(0, width, height, 0, -1, 1);
+            glMatrixMode(GL_MODELVIEW);
+            glLoadIdentity();
+            projectionDirty = false;
+        }
+        
+        // Render edges first
+        if (edgeLod) {
+            renderImage(edgeDensity);
+        } else {
+            renderEdges(edgeSubset);
+        }
+        
+        // Then render vertices
+        const std::vector<Vertex>& vertices = graph->getVertices();
+        if (vertexLod) {
+            renderImage(vertexCells);
+        } else if (vertexSubset) {
+            for (int index : *vertexSubset) {
+                renderVertex(index, vertices[index], radius);
+            }
+        } else {
+            for (size_t i = 0; i < vertices.size(); i++) {
+                renderVertex(static_cast<int>(i), vertices[i], radius);
+            }
+        }
     }
     
     // Swap front and back buffers
-    glfwSwapBuffers(window);
+    {
+        GC_TRACE_SCOPE("swap buffers");
+        glfwSwapBuffers(window);
+    }
     
-    // Poll for and process events
-    glfwPollEvents();
+    return true;
 }
 
-void Canvas::renderVertex(const Vertex& vertex) {
-    const float radius = 15.0f;
+void Canvas::markDirty() {
+    dirty = true;
+}
+
+void Canvas::setAnimating(bool animating) {
+    this->animating = animating;
+}
+
+bool Canvas::isAnimating() const {
+    return animating;
+}
+
+void Canvas::waitEvents(double timeoutSeconds) {
+    if (animating) {
+        glfwPollEvents();
+    } else {
+        glfwWaitEventsTimeout(timeoutSeconds);
+    }
+}
+
+void Canvas::wake() {
+    glfwPostEmptyEvent();
+}
+
+void Canvas::renderVertex(int index, const Vertex& vertex, float radius) {
     const int segments = 20;
     
-    float x = vertex.getX() * (width - 2 * radius) + radius;
-    float y = vertex.getY() * (height - 2 * radius) + radius;
+    // Unit circle, computed once
+    static float circleX[segments + 1];
+    static float circleY[segments + 1];
+    static bool circleReady = false;
+    if (!circleReady) {
+        for (int i = 0; i <= segments; i++) {
+            float angle = 2.0f * M_PI * i / segments;
+            circleX[i] = cos(angle);
+            circleY[i] = sin(angle);
+        }
+        circleReady = true;
+    }
+    
+    float x = screenPositions[2 * index];
+    float y = screenPositions[2 * index + 1];
     
     // Get the color for this vertex
-    int colorIndex = graph->getVertexColor(vertex.getId());
-    if (colorIndex < 0 || colorIndex >= MAX_COLORS) {
-        colorIndex = MAX_COLORS - 1; // Default to last color if invalid
-    }
+    const float* color = palette.getColor(paletteIndices[index]);
     
     // Set vertex color
-    glColor3f(colors[colorIndex][0], colors[colorIndex][1], colors[colorIndex][2]);
+    glColor3f(color[0], color[1], color[2]);
     
     // Draw filled circle
     glBegin(GL_TRIANGLE_FAN);
     glVertex2f(x, y); // Center
     for (int i = 0; i <= segments; i++) {
-        float angle = 2.0f * M_PI * i / segments;
-        float vx = x + radius * cos(angle);
-        float vy = y + radius * sin(angle);
-        glVertex2f(vx, vy);
+        glVertex2f(x + radius * circleX[i], y + radius * circleY[i]);
     }
     glEnd();
     
@@ -127,49 +460,67 @@ void Canvas::renderVertex(const Vertex& vertex) {
     glColor3f(0.0f, 0.0f, 0.0f);
     glBegin(GL_LINE_LOOP);
     for (int i = 0; i < segments; i++) {
-        float angle = 2.0f * M_PI * i / segments;
-        float vx = x + radius * cos(angle);
-        float vy = y + radius * sin(angle);
-        glVertex2f(vx, vy);
+        glVertex2f(x + radius * circleX[i], y + radius * circleY[i]);
     }
     glEnd();
     
-    // Render vertex ID
-    std::string idText = std::to_string(vertex.getId());
-    renderText(idText, x - 5.0f, y - 5.0f, 1.0f);
+    // Render vertex ID where there is room for it
+    if (radius >= 8.0f) {
+        std::string idText = std::to_string(vertex.getId());
+        renderText(idText, x - 5.0f, y - 5.0f, 1.0f);
+    }
 }
 
-void Canvas::renderEdge(const Edge& edge) {
-    Vertex* source = graph->getVertex(edge.getSourceId());
-    Vertex* target = graph->getVertex(edge.getTargetId());
-    
-    if (!source || !target) {
-        return;
-    }
-    
-    const float radius = 15.0f;
-    
-    float x1 = source->getX() * (width - 2 * radius) + radius;
-    float y1 = source->getY() * (height - 2 * radius) + radius;
-    float x2 = target->getX() * (width - 2 * radius) + radius;
-    float y2 = target->getY() * (height - 2 * radius) + radius;
-    
-    // Set edge color (black)
+void Canvas::renderEdges(const std::vector<int>* subset) {
+    // One pass over the cached endpoints; no vertex lookups per frame
     glColor3f(0.0f, 0.0f, 0.0f);
-    
-    // Set line width to make edges more visible
     glLineWidth(2.5f);
     
-    // Draw line
     glBegin(GL_LINES);
-    glVertex2f(x1, y1);
-    glVertex2f(x2, y2);
+    if (subset) {
+        for (int edge : *subset) {
+            const float* source = &screenPositions[2 * edgeEndpoints[2 * edge]];
+            const float* target = &screenPositions[2 * edgeEndpoints[2 * edge + 1]];
+            glVertex2f(source[0], source[1]);
+            glVertex2f(target[0], target[1]);
+        }
+    } else {
+        for (size_t i = 0; i < edgeEndpoints.size(); i++) {
+            const float* position = &screenPositions[2 * edgeEndpoints[i]];
+            glVertex2f(position[0], position[1]);
+        }
+    }
     glEnd();
     
     // Reset line width to default
     glLineWidth(1.0f);
 }
 
+void Canvas::renderImage(const DensityImage& image) {
+    // One blended quad per non-empty cell
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBegin(GL_QUADS);
+    for (int row = 0; row < image.rows; row++) {
+        for (int column = 0; column < image.columns; column++) {
+            const unsigned char* texel = &image.rgba[4 * (static_cast<size_t>(row) * image.columns + column)];
+            if (texel[3] == 0) {
+                continue;
+            }
+            float x = static_cast<float>(column * image.cellSize);
+            float y = static_cast<float>(row * image.cellSize);
+            float size = static_cast<float>(image.cellSize);
+            glColor4ub(texel[0], texel[1], texel[2], texel[3]);
+            glVertex2f(x, y);
+            glVertex2f(x + size, y);
+            glVertex2f(x + size, y + size);
+            glVertex2f(x, y + size);
+        }
+    }
+    glEnd();
+    glDisable(GL_BLEND);
+}
+
 void Canvas::renderText(const std::string& text, float x, float y, float scale) {
     // Simple rendering of text using lines (very basic)
     // In a real application, you would use a text rendering library like FreeType
@@ -191,6 +542,9 @@ bool Canvas::shouldClose() {
 
 void Canvas::close() {
     if (window) {
+        // The renderer's buffers belong to this window's context
+        glfwMakeContextCurrent(window);
+        renderer.release();
         glfwDestroyWindow(window);
         window = nullptr;
     }
@@ -206,6 +560,12 @@ void Canvas::processInput() {
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
         glfwSetWindowShouldClose(window, true);
     }
+    
+    // R resets the view to the whole layout
+    if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS) {
+        camera.reset();
+        dirty = true;
+    }
 }
 
 GLFWwindow* Canvas::getWindow() {
@@ -0,0 +1,3 @@
+// The glad loader is header-only; its implementation is compiled here once
+#define GLAD_GL_IMPLEMENTATION
+#include <glad/gl.h>
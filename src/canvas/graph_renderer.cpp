@@ -0,0 +1,475 @@
+#include "../../include/canvas/graph_renderer.hpp"
+#include "../../include/trace/trace.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace graph_coloring {
+
+namespace {
+
+// The palette texture holds the palette in rows of this many entries, so
+// its size stays within texture limits for any number of colors
+const int PALETTE_TEXTURE_WIDTH = 256;
+
+const char* CIRCLE_VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec2 corner;   // Quad corner in [-1, 1]
+layout(location = 1) in vec2 position; // Per instance: layout position in [0, 1]
+layout(location = 2) in int colorIndex;
+uniform vec2 viewport;
+uniform vec2 scale;
+uniform vec2 offset;
+uniform float radius;
+uniform sampler2D palette; // Rows of PALETTE_TEXTURE_WIDTH (256) entries
+out vec2 local;
+flat out vec3 fillColor;
+void main() {
+    vec2 center = position * scale + offset;
+    vec2 pixel = center + corner * radius;
+    gl_Position = vec4(pixel.x / viewport.x * 2.0 - 1.0, 1.0 - pixel.y / viewport.y * 2.0, 0.0, 1.0);
+    local = corner * radius;
+    fillColor = texelFetch(palette, ivec2(colorIndex % 256, colorIndex / 256), 0).rgb;
+}
+)";
+
+// Filled circle with a black outline and, on circles big enough for it, a
+// small black square in the middle (where the immediate mode path marks the vertex ID)
+const char* CIRCLE_FRAGMENT_SHADER = R"(#version 330 core
+in vec2 local;
+flat in vec3 fillColor;
+uniform float radius;
+out vec4 fragColor;
+void main() {
+    float distance = length(local);
+    if (distance > radius) {
+        discard;
+    }
+    bool outline = distance > radius - 1.0;
+    bool marker = radius >= 8.0 && abs(local.x) <= 5.0 && abs(local.y) <= 5.0;
+    fragColor = vec4(outline || marker ? vec3(0.0) : fillColor, 1.0);
+}
+)";
+
+const char* EDGE_VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec2 position;
+uniform vec2 viewport;
+uniform vec2 scale;
+uniform vec2 offset;
+void main() {
+    vec2 pixel = position * scale + offset;
+    gl_Position = vec4(pixel.x / viewport.x * 2.0 - 1.0, 1.0 - pixel.y / viewport.y * 2.0, 0.0, 1.0);
+}
+)";
+
+const char* EDGE_FRAGMENT_SHADER = R"(#version 330 core
+out vec4 fragColor;
+void main() {
+    fragColor = vec4(0.0, 0.0, 0.0, 1.0);
+}
+)";
+
+// A DensityImage stretched over the window, one texel per cell
+const char* IMAGE_VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec2 corner; // Quad corner in [-1, 1]
+uniform vec2 viewport;
+uniform vec2 size; // Pixels covered by the image
+out vec2 texCoord;
+void main() {
+    texCoord = corner * 0.5 + 0.5;
+    vec2 pixel = texCoord * size;
+    gl_Position = vec4(pixel.x / viewport.x * 2.0 - 1.0, 1.0 - pixel.y / viewport.y * 2.0, 0.0, 1.0);
+}
+)";
+
+const char* IMAGE_FRAGMENT_SHADER = R"(#version 330 core
+in vec2 texCoord;
+uniform sampler2D image;
+out vec4 fragColor;
+void main() {
+    fragColor = texture(image, texCoord);
+}
+)";
+
+GLuint compileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::cerr << "Shader compilation failed: " << log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+GLuint linkProgram(const char* vertexSource, const char* fragmentSource) {
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    if (!vertexShader || !fragmentShader) {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        std::cerr << "Shader link failed: " << log << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+} // namespace
+
+GraphRenderer::GraphRenderer()
+    : circleProgram(0), edgeProgram(0), imageProgram(0), circleArray(0), edgeArray(0), imageArray(0),
+      imageTexture(0), paletteTexture(0), quadBuffer(0), positionBuffer(0),
+      colorBuffer(0), edgeBuffer(0), subsetCircleArray(0), subsetEdgeArray(0), subsetPositionBuffer(0),
+      subsetColorBuffer(0), subsetEdgeBuffer(0), vertexCount(0), edgeIndexCount(0), ready(false),
+      structureVersion(0), edgeVersion(0), positionVersion(0), colorVersion(0), paletteColorCount(-1) {
+}
+
+GraphRenderer::~GraphRenderer() {
+    // GL objects need the context, so they are freed by release() while it is current
+}
+
+bool GraphRenderer::initialize() {
+    if (!GLAD_GL_VERSION_3_3) {
+        return false;
+    }
+
+    circleProgram = linkProgram(CIRCLE_VERTEX_SHADER, CIRCLE_FRAGMENT_SHADER);
+    edgeProgram = linkProgram(EDGE_VERTEX_SHADER, EDGE_FRAGMENT_SHADER);
+    imageProgram = linkProgram(IMAGE_VERTEX_SHADER, IMAGE_FRAGMENT_SHADER);
+    if (!circleProgram || !edgeProgram || !imageProgram) {
+        release();
+        return false;
+    }
+
+    glGenVertexArrays(1, &circleArray);
+    glGenVertexArrays(1, &edgeArray);
+    glGenBuffers(1, &quadBuffer);
+    glGenBuffers(1, &positionBuffer);
+    glGenBuffers(1, &colorBuffer);
+    glGenBuffers(1, &edgeBuffer);
+    glGenVertexArrays(1, &subsetCircleArray);
+    glGenVertexArrays(1, &subsetEdgeArray);
+    glGenBuffers(1, &subsetPositionBuffer);
+    glGenBuffers(1, &subsetColorBuffer);
+    glGenBuffers(1, &subsetEdgeBuffer);
+
+    const float quad[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+    glBindBuffer(GL_ARRAY_BUFFER, quadBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+
+    // Circles: a quad drawn once per vertex, positions and colors advance per instance
+    auto setupCircles = [this](GLuint array, GLuint positions, GLuint colors) {
+        glBindVertexArray(array);
+        glBindBuffer(GL_ARRAY_BUFFER, quadBuffer);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glBindBuffer(GL_ARRAY_BUFFER, positions);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glVertexAttribDivisor(1, 1);
+        glBindBuffer(GL_ARRAY_BUFFER, colors);
+        glEnableVertexAttribArray(2);
+        glVertexAttribIPointer(2, 1, GL_INT, 0, nullptr);
+        glVertexAttribDivisor(2, 1);
+    };
+    setupCircles(circleArray, positionBuffer, colorBuffer);
+    setupCircles(subsetCircleArray, subsetPositionBuffer, subsetColorBuffer);
+
+    // Edges: the same positions, indexed in pairs
+    auto setupEdges = [this](GLuint array, GLuint indices) {
+        glBindVertexArray(array);
+        glBindBuffer(GL_ARRAY_BUFFER, positionBuffer);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices);
+    };
+    setupEdges(edgeArray, edgeBuffer);
+    setupEdges(subsetEdgeArray, subsetEdgeBuffer);
+
+    // Density images: the quad alone, sampled without filtering so cells stay crisp
+    glGenVertexArrays(1, &imageArray);
+    glBindVertexArray(imageArray);
+    glBindBuffer(GL_ARRAY_BUFFER, quadBuffer);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glGenTextures(1, &imageTexture);
+    glBindTexture(GL_TEXTURE_2D, imageTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // Palette: read with texelFetch, so no filtering or mipmaps
+    glGenTextures(1, &paletteTexture);
+    glBindTexture(GL_TEXTURE_2D, paletteTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    ready = true;
+    return true;
+}
+
+void GraphRenderer::uploadStructure(Graph& graph) {
+    vertexCount = static_cast<GLsizei>(graph.getVertices().size());
+    structureVersion = graph.getStructureVersion();
+
+    // Vertex buffers change size with the structure
+    positionVersion = 0;
+    colorVersion = 0;
+}
+
+void GraphRenderer::uploadEdges(Graph& graph, const std::vector<int>& edgeEndpoints) {
+    GC_TRACE_SCOPE("upload edges");
+
+    // Dense indices are non-negative, so the ints upload as GL_UNSIGNED_INT as they are.
+    // The element buffer binding is VAO state, so bind the edge VAO first.
+    static_assert(sizeof(int) == sizeof(GLuint), "edge endpoints must match the index type");
+    glBindVertexArray(edgeArray);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, edgeBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, edgeEndpoints.size() * sizeof(GLuint), edgeEndpoints.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+
+    edgeIndexCount = static_cast<GLsizei>(edgeEndpoints.size());
+    edgeVersion = graph.getStructureVersion();
+}
+
+void GraphRenderer::uploadPositions(Graph& graph) {
+    GC_TRACE_SCOPE("upload positions");
+
+    const std::vector<Vertex>& vertices = graph.getVertices();
+    positions.clear();
+    positions.reserve(vertices.size() * 2);
+    for (const auto& vertex : vertices) {
+        positions.push_back(vertex.getX());
+        positions.push_back(vertex.getY());
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, positionBuffer);
+    if (positionVersion == 0) {
+        glBufferData(GL_ARRAY_BUFFER, positions.size() * sizeof(float), positions.data(), GL_DYNAMIC_DRAW);
+    } else {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, positions.size() * sizeof(float), positions.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    positionVersion = graph.getPositionVersion();
+}
+
+void GraphRenderer::uploadColors(Graph& graph, const Palette& palette) {
+    GC_TRACE_SCOPE("upload colors");
+
+    const std::vector<Vertex>& vertices = graph.getVertices();
+    colors.clear();
+    colors.reserve(vertices.size());
+    for (const auto& vertex : vertices) {
+        colors.push_back(palette.indexOf(graph.getVertexColor(vertex.getId())));
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, colorBuffer);
+    if (colorVersion == 0) {
+        glBufferData(GL_ARRAY_BUFFER, colors.size() * sizeof(GLint), colors.data(), GL_DYNAMIC_DRAW);
+    } else {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, colors.size() * sizeof(GLint), colors.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    colorVersion = graph.getColorVersion();
+}
+
+void GraphRenderer::uploadPalette(const Palette& palette) {
+    // Padded to whole rows of the texture
+    int rows = (palette.getSize() + PALETTE_TEXTURE_WIDTH - 1) / PALETTE_TEXTURE_WIDTH;
+    std::vector<float> texels(static_cast<size_t>(rows) * PALETTE_TEXTURE_WIDTH * 3, 0.0f);
+    std::copy(palette.data(), palette.data() + palette.getSize() * 3, texels.begin());
+
+    glBindTexture(GL_TEXTURE_2D, paletteTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, PALETTE_TEXTURE_WIDTH, rows, 0, GL_RGB, GL_FLOAT, texels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    paletteColorCount = palette.getColorCount();
+}
+
+void GraphRenderer::update(Graph& graph) {
+    // Only what changed since the last frame goes to the GPU
+    if (graph.getStructureVersion() != structureVersion) {
+        uploadStructure(graph);
+    }
+    if (graph.getPositionVersion() != positionVersion) {
+        uploadPositions(graph);
+    }
+}
+
+void GraphRenderer::setView(GLuint program, const Camera& camera) {
+    glUseProgram(program);
+    glUniform2f(glGetUniformLocation(program, "viewport"), static_cast<float>(camera.getWidth()),
+                static_cast<float>(camera.getHeight()));
+    glUniform2f(glGetUniformLocation(program, "scale"), camera.getScaleX(), camera.getScaleY());
+    glUniform2f(glGetUniformLocation(program, "offset"), camera.getOffsetX(), camera.getOffsetY());
+}
+
+void GraphRenderer::drawEdges(Graph& graph, const std::vector<int>& edgeEndpoints, const Camera& camera,
+                              const std::vector<int>* subset) {
+    if (!ready || camera.getWidth() <= 0 || camera.getHeight() <= 0) {
+        return;
+    }
+    update(graph);
+    if (graph.getStructureVersion() != edgeVersion) {
+        uploadEdges(graph, edgeEndpoints);
+    }
+
+    GC_TRACE_SCOPE("draw edges");
+    setView(edgeProgram, camera);
+    glLineWidth(2.5f);
+    if (subset) {
+        subsetEdgeIndices.clear();
+        for (int edge : *subset) {
+            subsetEdgeIndices.push_back(static_cast<GLuint>(edgeEndpoints[2 * edge]));
+            subsetEdgeIndices.push_back(static_cast<GLuint>(edgeEndpoints[2 * edge + 1]));
+        }
+        glBindVertexArray(subsetEdgeArray);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, subsetEdgeIndices.size() * sizeof(GLuint), subsetEdgeIndices.data(),
+                     GL_STREAM_DRAW);
+        glDrawElements(GL_LINES, static_cast<GLsizei>(subsetEdgeIndices.size()), GL_UNSIGNED_INT, nullptr);
+    } else {
+        glBindVertexArray(edgeArray);
+        glDrawElements(GL_LINES, edgeIndexCount, GL_UNSIGNED_INT, nullptr);
+    }
+    glLineWidth(1.0f);
+
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
+
+void GraphRenderer::drawVertices(Graph& graph, const Camera& camera, float radius, const Palette& palette,
+                                 const std::vector<int>* subset) {
+    if (!ready || camera.getWidth() <= 0 || camera.getHeight() <= 0) {
+        return;
+    }
+    update(graph);
+    // Palette indices depend on the palette's size (the uncolored entry comes last)
+    if (palette.getColorCount() != paletteColorCount) {
+        uploadPalette(palette);
+        colorVersion = 0;
+    }
+    if (graph.getColorVersion() != colorVersion) {
+        uploadColors(graph, palette);
+    }
+
+    GC_TRACE_SCOPE("draw vertices");
+    setView(circleProgram, camera);
+    glUniform1f(glGetUniformLocation(circleProgram, "radius"), radius);
+    glUniform1i(glGetUniformLocation(circleProgram, "palette"), 0);
+    glBindTexture(GL_TEXTURE_2D, paletteTexture);
+    if (subset) {
+        subsetPositions.clear();
+        subsetColors.clear();
+        for (int vertex : *subset) {
+            subsetPositions.push_back(positions[2 * vertex]);
+            subsetPositions.push_back(positions[2 * vertex + 1]);
+            subsetColors.push_back(colors[vertex]);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, subsetPositionBuffer);
+        glBufferData(GL_ARRAY_BUFFER, subsetPositions.size() * sizeof(float), subsetPositions.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, subsetColorBuffer);
+        glBufferData(GL_ARRAY_BUFFER, subsetColors.size() * sizeof(GLint), subsetColors.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(subsetCircleArray);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(subsetColors.size()));
+    } else {
+        glBindVertexArray(circleArray);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, vertexCount);
+    }
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+}
+
+void GraphRenderer::drawImage(const DensityImage& image, const Camera& camera) {
+    if (!ready || image.rgba.empty()) {
+        return;
+    }
+
+    GC_TRACE_SCOPE("draw density image");
+    glBindTexture(GL_TEXTURE_2D, imageTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.columns, image.rows, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 image.rgba.data());
+
+    glUseProgram(imageProgram);
+    glUniform2f(glGetUniformLocation(imageProgram, "viewport"), static_cast<float>(camera.getWidth()),
+                static_cast<float>(camera.getHeight()));
+    glUniform2f(glGetUniformLocation(imageProgram, "size"), static_cast<float>(image.columns * image.cellSize),
+                static_cast<float>(image.rows * image.cellSize));
+    glUniform1i(glGetUniformLocation(imageProgram, "image"), 0);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBindVertexArray(imageArray);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glDisable(GL_BLEND);
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+}
+
+void GraphRenderer::release() {
+    if (circleArray) {
+        glDeleteVertexArrays(1, &circleArray);
+        glDeleteVertexArrays(1, &edgeArray);
+        glDeleteBuffers(1, &quadBuffer);
+        glDeleteBuffers(1, &positionBuffer);
+        glDeleteBuffers(1, &colorBuffer);
+        glDeleteBuffers(1, &edgeBuffer);
+        glDeleteVertexArrays(1, &subsetCircleArray);
+        glDeleteVertexArrays(1, &subsetEdgeArray);
+        glDeleteBuffers(1, &subsetPositionBuffer);
+        glDeleteBuffers(1, &subsetColorBuffer);
+        glDeleteBuffers(1, &subsetEdgeBuffer);
+        glDeleteVertexArrays(1, &imageArray);
+        glDeleteTextures(1, &imageTexture);
+        glDeleteTextures(1, &paletteTexture);
+    }
+    if (circleProgram) {
+        glDeleteProgram(circleProgram);
+    }
+    if (edgeProgram) {
+        glDeleteProgram(edgeProgram);
+    }
+    if (imageProgram) {
+        glDeleteProgram(imageProgram);
+    }
+
+    circleProgram = edgeProgram = imageProgram = 0;
+    circleArray = edgeArray = imageArray = 0;
+    imageTexture = paletteTexture = 0;
+    quadBuffer = positionBuffer = colorBuffer = edgeBuffer = 0;
+    subsetCircleArray = subsetEdgeArray = 0;
+    subsetPositionBuffer = subsetColorBuffer = subsetEdgeBuffer = 0;
+    structureVersion = edgeVersion = positionVersion = colorVersion = 0;
+    paletteColorCount = -1;
+    ready = false;
+}
+
+} // namespace graph_coloring
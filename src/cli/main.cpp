@@ -0,0 +1,230 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <csignal>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../include/batch/batch_runner.hpp"
+#include "../../include/io/progress_printer.hpp"
+#include "../../include/io/result_writer.hpp"
+#include "../../include/layout/force_layout.hpp"
+#include "../../include/parallel/thread_pool.hpp"
+#include "../../include/trace/trace.hpp"
+
+// Headless batch coloring: links only graphcoloring_core, so it builds and
+// runs on machines without GLFW, OpenGL or a display
+
+using namespace graph_coloring;
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: graphcoloring_cli [options] <file|glob|@list>..." << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --algorithm=<alg>    Coloring algorithm: 'greedy', 'sf', 'sl', 'dsatur', 'rlf', 'exact'" << std::endl;
+    std::cout << "                       or 'portfolio' to race them all (default: greedy)" << std::endl;
+    std::cout << "  --time-limit=<sec>   Stop each solve after this long and keep its best coloring" << std::endl;
+    std::cout << "  --node-limit=<n>     Stop exact search after this many assignments" << std::endl;
+    std::cout << "  --checkpoint-dir=<d> Save exact/portfolio search state to <d>/<name>.ckpt" << std::endl;
+    std::cout << "  --checkpoint-interval=<sec>  Seconds between checkpoints (default: 60)" << std::endl;
+    std::cout << "  --resume             Continue from the checkpoints in --checkpoint-dir" << std::endl;
+    std::cout << "  --jobs=<n>           Graphs colored at once (default: one per pool thread)" << std::endl;
+    std::cout << "  --threads=<n>        Worker threads in the shared thread pool (default: all cores)" << std::endl;
+    std::cout << "  --pin-threads        Pin each pool thread to one CPU" << std::endl;
+    std::cout << "  --output=<dir>       Write each coloring to <dir>/<name>.<ext>" << std::endl;
+    std::cout << "  --format=<fmt>       Output format: 'text', 'binary' or 'classes' (default: text)" << std::endl;
+    std::cout << "  --render=<dir>       Draw each colored graph to <dir>/<name>.<ext>" << std::endl;
+    std::cout << "  --image-size=<px>    Width and height of --render images (default: 1024)" << std::endl;
+    std::cout << "  --image-format=<fmt> 'png' or 'tiff' (tiled, streamed to disk for huge images; default: png)" << std::endl;
+    std::cout << "  --layout=<alg>       Vertex positions for --render: 'circular' (default), 'force' or 'multilevel'" << std::endl;
+    std::cout << "  --async-write        Write colorings on a background thread" << std::endl;
+    std::cout << "  --summary=<file>     Write the CSV summary to a file instead of stdout" << std::endl;
+    std::cout << "  --stats=<file>       Write per-file solver stats as JSON lines" << std::endl;
+    std::cout << "  --trace=<file>       Write a Chrome trace of solver and render zones on exit" << std::endl;
+    std::cout << "  --progress           Print each improvement (colors, lower bound, time, nodes) to stderr" << std::endl;
+    std::cout << "  --help               Show this help message" << std::endl;
+    std::cout << "<name> is the input's path relative to the deepest directory holding all inputs." << std::endl;
+}
+
+// Cancelled by SIGINT/SIGTERM so solves stop, save their checkpoints and the
+// batch exits cleanly; a second signal kills the process as usual
+CancellationToken interruptToken;
+
+extern "C" void handleInterrupt(int signal) {
+    interruptToken.cancel();
+    std::signal(signal, SIG_DFL);
+}
+
+int runBatch(const BatchOptions& options, const std::string& summaryPath, const std::string& statsPath) {
+    std::vector<BatchResult> results;
+    auto startTime = std::chrono::steady_clock::now();
+    try {
+        BatchRunner runner(options);
+        results = runner.run();
+    } catch (const std::exception& e) {
+        std::cerr << "Batch run failed: " << e.what() << std::endl;
+        return 1;
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+
+    if (summaryPath.empty()) {
+        BatchRunner::writeSummary(std::cout, results);
+    } else {
+        std::ofstream summary(summaryPath);
+        if (!summary) {
+            std::cerr << "Cannot write summary: " << summaryPath << std::endl;
+            return 1;
+        }
+        BatchRunner::writeSummary(summary, results);
+    }
+
+    if (!statsPath.empty()) {
+        std::ofstream stats(statsPath);
+        if (!stats) {
+            std::cerr << "Cannot write stats: " << statsPath << std::endl;
+            return 1;
+        }
+        BatchRunner::writeStats(stats, results);
+    }
+
+    int failures = 0;
+    for (const auto& result : results) {
+        if (!result.ok || !result.valid) {
+            failures++;
+        }
+    }
+    std::cerr << "Colored " << results.size() - failures << "/" << results.size()
+              << " graphs in " << duration.count() << " ms" << std::endl;
+
+    return failures == 0 ? 0 : 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BatchOptions batchOptions;
+    std::string summaryPath;
+    std::string statsPath;
+    std::string tracePath;
+    int poolThreads = 0;
+    bool pinThreads = false;
+    bool showProgress = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--help") {
+            printUsage();
+            return 0;
+        } else if (arg.find("--algorithm=") == 0) {
+            std::string value = arg.substr(12);
+            if (!parseColoringAlgorithm(value, batchOptions.algorithm)) {
+                std::cerr << "Invalid algorithm: " << value << std::endl;
+                printUsage();
+                return 1;
+            }
+        } else if (arg.find("--time-limit=") == 0) {
+            batchOptions.solve.timeLimitSeconds = std::atof(arg.substr(13).c_str());
+        } else if (arg.find("--node-limit=") == 0) {
+            batchOptions.solve.nodeLimit = std::atoll(arg.substr(13).c_str());
+        } else if (arg.find("--checkpoint-dir=") == 0) {
+            batchOptions.checkpointDir = arg.substr(17);
+        } else if (arg.find("--checkpoint-interval=") == 0) {
+            batchOptions.solve.checkpointIntervalSeconds = std::atof(arg.substr(22).c_str());
+        } else if (arg == "--resume") {
+            batchOptions.solve.resume = true;
+        } else if (arg == "--headless") {
+            // Accepted so command lines written for the viewer's old batch mode keep working
+        } else if (arg.find("--jobs=") == 0) {
+            batchOptions.threads = std::atoi(arg.substr(7).c_str());
+        } else if (arg.find("--threads=") == 0) {
+            poolThreads = std::atoi(arg.substr(10).c_str());
+        } else if (arg == "--pin-threads") {
+            pinThreads = true;
+        } else if (arg.find("--output=") == 0) {
+            batchOptions.outputDir = arg.substr(9);
+        } else if (arg.find("--format=") == 0) {
+            std::string value = arg.substr(9);
+            if (!ResultWriter::parseFormat(value, batchOptions.outputFormat)) {
+                std::cerr << "Invalid output format: " << value << std::endl;
+                printUsage();
+                return 1;
+            }
+        } else if (arg.find("--render=") == 0) {
+            batchOptions.imageDir = arg.substr(9);
+        } else if (arg.find("--image-size=") == 0) {
+            int size = std::atoi(arg.substr(13).c_str());
+            if (size <= 0) {
+                std::cerr << "Invalid image size: " << arg.substr(13) << std::endl;
+                printUsage();
+                return 1;
+            }
+            batchOptions.imageStyle.width = size;
+            batchOptions.imageStyle.height = size;
+        } else if (arg.find("--image-format=") == 0) {
+            std::string value = arg.substr(15);
+            if (!parseImageFormat(value, batchOptions.imageFormat)) {
+                std::cerr << "Invalid image format: " << value << std::endl;
+                printUsage();
+                return 1;
+            }
+        } else if (arg.find("--layout=") == 0) {
+            std::string value = arg.substr(9);
+            if (!parseLayoutAlgorithm(value, batchOptions.layout)) {
+                std::cerr << "Invalid layout: " << value << std::endl;
+                printUsage();
+                return 1;
+            }
+        } else if (arg == "--async-write") {
+            batchOptions.asyncWrite = true;
+        } else if (arg.find("--summary=") == 0) {
+            summaryPath = arg.substr(10);
+        } else if (arg.find("--stats=") == 0) {
+            statsPath = arg.substr(8);
+        } else if (arg.find("--trace=") == 0) {
+            tracePath = arg.substr(8);
+        } else if (arg == "--progress") {
+            showProgress = true;
+        } else if (arg.find("--") != 0) {
+            batchOptions.inputs.push_back(arg);
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (batchOptions.inputs.empty()) {
+        std::cerr << "No input files given" << std::endl;
+        printUsage();
+        return 1;
+    }
+
+    if (batchOptions.solve.resume && batchOptions.checkpointDir.empty()) {
+        std::cerr << "--resume needs --checkpoint-dir" << std::endl;
+        printUsage();
+        return 1;
+    }
+
+    ThreadPool::configureGlobal(poolThreads, pinThreads);
+    startTracing(tracePath);
+
+    std::unique_ptr<ProgressPrinter> progressPrinter;
+    if (showProgress) {
+        progressPrinter = std::make_unique<ProgressPrinter>();
+        ProgressPrinter* printer = progressPrinter.get();
+        batchOptions.progress = [printer](const std::string& path, const SolveProgress& progress) {
+            printer->push(path, progress);
+        };
+    }
+
+    batchOptions.solve.cancellation = &interruptToken;
+    std::signal(SIGINT, handleInterrupt);
+    std::signal(SIGTERM, handleInterrupt);
+    int status = runBatch(batchOptions, summaryPath, statsPath);
+    progressPrinter.reset();
+    finishTracing(tracePath);
+    return status;
+}
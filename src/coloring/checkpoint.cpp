@@ -0,0 +1,225 @@
+#include "../../include/coloring/checkpoint.hpp"
+#include "../../include/trace/trace.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace graph_coloring {
+
+namespace {
+
+const char CHECKPOINT_MAGIC[4] = {'G', 'C', 'C', 'P'};
+const uint32_t CHECKPOINT_VERSION = 1;
+
+void writeValue(std::ostream& out, uint64_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeInts(std::ostream& out, const std::vector<int>& values) {
+    writeValue(out, values.size());
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int));
+}
+
+void writeString(std::ostream& out, const std::string& text) {
+    writeValue(out, text.size());
+    out.write(text.data(), text.size());
+}
+
+uint64_t readValue(std::istream& in) {
+    uint64_t value = 0;
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+        throw std::runtime_error("Truncated checkpoint");
+    }
+    return value;
+}
+
+// Sizes are checked against the stream length so a corrupt file can't ask for huge allocations
+uint64_t readSize(std::istream& in, uint64_t remaining, size_t elementSize) {
+    uint64_t size = readValue(in);
+    if (size > remaining / elementSize) {
+        throw std::runtime_error("Corrupt checkpoint");
+    }
+    return size;
+}
+
+std::vector<int> readInts(std::istream& in, uint64_t remaining) {
+    std::vector<int> values(readSize(in, remaining, sizeof(int)));
+    if (!in.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(int))) {
+        throw std::runtime_error("Truncated checkpoint");
+    }
+    return values;
+}
+
+std::string readString(std::istream& in, uint64_t remaining) {
+    std::string text(readSize(in, remaining, 1), '\0');
+    if (!in.read(&text[0], text.size())) {
+        throw std::runtime_error("Truncated checkpoint");
+    }
+    return text;
+}
+
+std::chrono::steady_clock::rep nextSaveAfter(std::chrono::steady_clock::duration interval) {
+    return (std::chrono::steady_clock::now() + interval).time_since_epoch().count();
+}
+
+} // namespace
+
+uint64_t checkpointGraphHash(const CsrGraph& csr) {
+    // FNV-1a over the vertex count and every adjacency list
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+
+    mix(static_cast<uint64_t>(csr.getVertexCount()));
+    for (int v = 0; v < csr.getVertexCount(); v++) {
+        mix(static_cast<uint64_t>(csr.getDegree(v)));
+        for (const int* it = csr.neighborsBegin(v); it != csr.neighborsEnd(v); ++it) {
+            mix(static_cast<uint64_t>(*it));
+        }
+    }
+    return hash;
+}
+
+void writeCheckpoint(const std::string& path, const SearchCheckpoint& checkpoint) {
+    GC_TRACE_SCOPE("write checkpoint");
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot write checkpoint: " + tempPath);
+        }
+
+        out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        out.write(reinterpret_cast<const char*>(&CHECKPOINT_VERSION), sizeof(CHECKPOINT_VERSION));
+        writeString(out, checkpoint.algorithm);
+        writeValue(out, checkpoint.graphHash);
+        writeInts(out, checkpoint.best);
+        writeValue(out, static_cast<uint64_t>(checkpoint.lowerBound));
+        writeValue(out, static_cast<uint64_t>(checkpoint.exactTarget));
+        writeInts(out, checkpoint.exactPath);
+        writeValue(out, static_cast<uint64_t>(checkpoint.localTarget));
+        writeInts(out, checkpoint.localColoring);
+        writeString(out, checkpoint.localRngState);
+
+        if (!out.flush()) {
+            throw std::runtime_error("Cannot write checkpoint: " + tempPath);
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        throw std::runtime_error("Cannot replace checkpoint: " + path + " (" + ec.message() + ")");
+    }
+}
+
+bool readCheckpoint(const std::string& path, SearchCheckpoint& checkpoint) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return false;
+    }
+    uint64_t remaining = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    uint32_t version = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0 ||
+        !in.read(reinterpret_cast<char*>(&version), sizeof(version))) {
+        throw std::runtime_error("Not a checkpoint file: " + path);
+    }
+    if (version != CHECKPOINT_VERSION) {
+        throw std::runtime_error("Unsupported checkpoint version in " + path);
+    }
+
+    checkpoint.algorithm = readString(in, remaining);
+    checkpoint.graphHash = readValue(in);
+    checkpoint.best = readInts(in, remaining);
+    checkpoint.lowerBound = static_cast<int>(readValue(in));
+    checkpoint.exactTarget = static_cast<int>(readValue(in));
+    checkpoint.exactPath = readInts(in, remaining);
+    checkpoint.localTarget = static_cast<int>(readValue(in));
+    checkpoint.localColoring = readInts(in, remaining);
+    checkpoint.localRngState = readString(in, remaining);
+    return true;
+}
+
+Checkpointer::Checkpointer(const std::string& path, double intervalSeconds, const CsrGraph& csr,
+                           const char* algorithm)
+    : path(path),
+      interval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(intervalSeconds))),
+      nextSave(nextSaveAfter(interval)),
+      hasResumed(false) {
+    state.algorithm = algorithm;
+    state.graphHash = checkpointGraphHash(csr);
+}
+
+bool Checkpointer::resume() {
+    SearchCheckpoint loaded;
+    if (!readCheckpoint(path, loaded)) {
+        return false;
+    }
+    if (loaded.algorithm != state.algorithm) {
+        throw std::runtime_error("Checkpoint " + path + " was written by '" + loaded.algorithm + "', not '" +
+                                 state.algorithm + "'");
+    }
+    if (loaded.graphHash != state.graphHash) {
+        throw std::runtime_error("Checkpoint " + path + " was written for a different graph");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    resumed = loaded;
+    hasResumed = true;
+    state = loaded;
+    return true;
+}
+
+bool Checkpointer::isDue() const {
+    return std::chrono::steady_clock::now().time_since_epoch().count() >= nextSave.load(std::memory_order_relaxed);
+}
+
+void Checkpointer::updateBest(const std::vector<int>& best, int lowerBound) {
+    std::lock_guard<std::mutex> lock(mutex);
+    state.best = best;
+    state.lowerBound = lowerBound;
+}
+
+void Checkpointer::updateExact(int target, const std::vector<int>& coloring, int depth) {
+    std::lock_guard<std::mutex> lock(mutex);
+    state.exactTarget = target;
+    state.exactPath.assign(coloring.begin(), coloring.begin() + depth);
+}
+
+void Checkpointer::updateLocalSearch(int target, const std::vector<int>& coloring, const std::mt19937& rng) {
+    std::ostringstream rngState;
+    rngState << rng;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    state.localTarget = target;
+    state.localColoring = coloring;
+    state.localRngState = rngState.str();
+}
+
+void Checkpointer::save() {
+    std::lock_guard<std::mutex> lock(mutex);
+    nextSave.store(nextSaveAfter(interval), std::memory_order_relaxed);
+    writeCheckpoint(path, state);
+}
+
+void Checkpointer::saveIfDue() {
+    if (isDue()) {
+        save();
+    }
+}
+
+void Checkpointer::discard() {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+} // namespace graph_coloring
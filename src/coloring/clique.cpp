@@ -0,0 +1,57 @@
+#include "../../include/coloring/algorithms.hpp"
+#include <algorithm>
+
+namespace graph_coloring {
+namespace algorithms {
+
+int greedyCliqueSize(const CsrGraph& csr) {
+    // Number of highest degree vertices a clique is grown from
+    const int MAX_STARTS = 64;
+    
+    int n = csr.getVertexCount();
+    std::vector<int> byDegree = largestDegreeOrder(csr);
+    std::vector<int> hits(n, 0); // Clique members adjacent to each vertex
+    std::vector<int> touched;
+    std::vector<int> candidates;
+    int best = n > 0 ? 1 : 0;
+    
+    for (int s = 0; s < std::min(n, MAX_STARTS); s++) {
+        int start = byDegree[s];
+        if (csr.getDegree(start) < best) {
+            break; // No larger clique can contain this vertex
+        }
+        
+        // Try neighbors of the start vertex, highest degree first
+        candidates.assign(csr.neighborsBegin(start), csr.neighborsEnd(start));
+        std::sort(candidates.begin(), candidates.end(), [&csr](int a, int b) {
+            return csr.getDegree(a) > csr.getDegree(b);
+        });
+        
+        int size = 0;
+        auto addMember = [&](int v) {
+            size++;
+            for (const int* it = csr.neighborsBegin(v); it != csr.neighborsEnd(v); ++it) {
+                if (hits[*it]++ == 0) {
+                    touched.push_back(*it);
+                }
+            }
+        };
+        addMember(start);
+        for (int v : candidates) {
+            if (hits[v] == size) {
+                addMember(v);
+            }
+        }
+        best = std::max(best, size);
+        
+        for (int v : touched) {
+            hits[v] = 0;
+        }
+        touched.clear();
+    }
+    
+    return best;
+}
+
+} // namespace algorithms
+} // namespace graph_coloring
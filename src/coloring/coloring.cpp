@@ -0,0 +1,63 @@
+#include "../../include/coloring/coloring.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace graph_coloring {
+
+Coloring::Coloring()
+    : colors(std::make_shared<const std::vector<int>>()), numColors(0), algorithm(ColoringAlgorithm::Greedy),
+      status(SolveStatus::Complete) {
+}
+
+Coloring::Coloring(std::vector<int> colors, ColoringAlgorithm algorithm, const SolverStats& stats,
+                   SolveStatus status)
+    : colors(std::make_shared<const std::vector<int>>(std::move(colors))), numColors(0),
+      algorithm(algorithm), status(status), stats(stats) {
+    // Colors are zero-indexed; uncolored vertices (-1) don't count
+    for (int color : *this->colors) {
+        numColors = std::max(numColors, color + 1);
+    }
+}
+
+Coloring::Coloring(const Coloring& other, const SolverStats& stats)
+    : colors(other.colors), numColors(other.numColors), algorithm(other.algorithm), status(other.status),
+      stats(stats) {
+}
+
+const std::vector<int>& Coloring::getColors() const {
+    return *colors;
+}
+
+int Coloring::getColor(int index) const {
+    return (*colors)[index];
+}
+
+int Coloring::getNumberOfColors() const {
+    return numColors;
+}
+
+int Coloring::getVertexCount() const {
+    return static_cast<int>(colors->size());
+}
+
+ColoringAlgorithm Coloring::getAlgorithm() const {
+    return algorithm;
+}
+
+SolveStatus Coloring::getStatus() const {
+    return status;
+}
+
+const SolverStats& Coloring::getStats() const {
+    return stats;
+}
+
+bool Coloring::isValid() const {
+    return stats.valid;
+}
+
+bool Coloring::isEmpty() const {
+    return colors->empty();
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,51 @@
+#include "../../include/coloring/coloring_algorithm.hpp"
+
+namespace graph_coloring {
+
+const char* coloringAlgorithmName(ColoringAlgorithm algorithm) {
+    switch (algorithm) {
+        case ColoringAlgorithm::SF:
+            return "sf";
+        case ColoringAlgorithm::Exact:
+            return "exact";
+        case ColoringAlgorithm::SmallestLast:
+            return "sl";
+        case ColoringAlgorithm::DSatur:
+            return "dsatur";
+        case ColoringAlgorithm::RLF:
+            return "rlf";
+        case ColoringAlgorithm::Portfolio:
+            return "portfolio";
+        case ColoringAlgorithm::Greedy:
+        default:
+            return "greedy";
+    }
+}
+
+std::vector<ColoringAlgorithm> allColoringAlgorithms() {
+    return {ColoringAlgorithm::Greedy, ColoringAlgorithm::SF, ColoringAlgorithm::Exact,
+            ColoringAlgorithm::SmallestLast, ColoringAlgorithm::DSatur, ColoringAlgorithm::RLF};
+}
+
+bool parseColoringAlgorithm(const std::string& name, ColoringAlgorithm& algorithm) {
+    if (name == "greedy") {
+        algorithm = ColoringAlgorithm::Greedy;
+    } else if (name == "sf") {
+        algorithm = ColoringAlgorithm::SF;
+    } else if (name == "exact") {
+        algorithm = ColoringAlgorithm::Exact;
+    } else if (name == "sl") {
+        algorithm = ColoringAlgorithm::SmallestLast;
+    } else if (name == "dsatur") {
+        algorithm = ColoringAlgorithm::DSatur;
+    } else if (name == "rlf") {
+        algorithm = ColoringAlgorithm::RLF;
+    } else if (name == "portfolio") {
+        algorithm = ColoringAlgorithm::Portfolio;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace graph_coloring
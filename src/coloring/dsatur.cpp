@@ -0,0 +1,92 @@
+#include "../../include/coloring/algorithms.hpp"
+#include <cstdint>
+#include <set>
+#include <tuple>
+
+namespace graph_coloring {
+namespace algorithms {
+
+namespace {
+
+// Per-vertex set of neighbor colors as a bitmap that grows with the largest color seen
+class ColorSet {
+private:
+    std::vector<uint64_t> words;
+
+public:
+    // Adds a color; returns true if it was not in the set yet
+    bool insert(int color) {
+        size_t word = static_cast<size_t>(color) / 64;
+        uint64_t bit = uint64_t(1) << (color % 64);
+        if (word >= words.size()) {
+            words.resize(word + 1, 0);
+        }
+        if (words[word] & bit) {
+            return false;
+        }
+        words[word] |= bit;
+        return true;
+    }
+    
+    // Smallest color not in the set
+    int firstFree() const {
+        for (size_t word = 0; word < words.size(); word++) {
+            if (words[word] != ~uint64_t(0)) {
+                int bit = 0;
+                while (words[word] & (uint64_t(1) << bit)) {
+                    bit++;
+                }
+                return static_cast<int>(word * 64) + bit;
+            }
+        }
+        return static_cast<int>(words.size() * 64);
+    }
+};
+
+} // namespace
+
+bool dsaturColoring(const CsrGraph& csr, std::vector<int>& coloring, const CancellationToken* cancel) {
+    int n = csr.getVertexCount();
+    std::vector<ColorSet> neighborColors(n);
+    std::vector<int> saturation(n, 0);
+    std::vector<int> uncoloredDegree(n);
+    
+    // Highest saturation first, ties broken by degree among uncolored vertices
+    std::set<std::tuple<int, int, int>> queue;
+    for (int v = 0; v < n; v++) {
+        coloring[v] = -1;
+        uncoloredDegree[v] = csr.getDegree(v);
+        queue.insert(std::make_tuple(0, uncoloredDegree[v], -v));
+    }
+    
+    for (int step = 0; !queue.empty(); step++) {
+        if (cancel && (step & 255) == 0 && cancel->isCancelled()) {
+            return false;
+        }
+        
+        auto top = std::prev(queue.end());
+        int v = -std::get<2>(*top);
+        queue.erase(top);
+        
+        int color = neighborColors[v].firstFree();
+        coloring[v] = color;
+        
+        for (const int* it = csr.neighborsBegin(v); it != csr.neighborsEnd(v); ++it) {
+            int u = *it;
+            if (coloring[u] >= 0) {
+                continue;
+            }
+            queue.erase(std::make_tuple(saturation[u], uncoloredDegree[u], -u));
+            if (neighborColors[u].insert(color)) {
+                saturation[u]++;
+            }
+            uncoloredDegree[u]--;
+            queue.insert(std::make_tuple(saturation[u], uncoloredDegree[u], -u));
+        }
+    }
+    
+    return true;
+}
+
+} // namespace algorithms
+} // namespace graph_coloring
@@ -0,0 +1,192 @@
+#include "../../include/coloring/algorithms.hpp"
+#include <algorithm>
+
+namespace graph_coloring {
+namespace algorithms {
+
+namespace {
+
+bool isSafeColor(const CsrGraph& csr, int vertexIndex, int color, const std::vector<int>& coloring) {
+    // Check if any adjacent vertex has the same color
+    for (const int* it = csr.neighborsBegin(vertexIndex); it != csr.neighborsEnd(vertexIndex); ++it) {
+        if (coloring[*it] == color) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+// Colors used by any vertex before depth
+int colorsUsed(const std::vector<int>& coloring, int depth) {
+    int used = 0;
+    for (int v = 0; v < depth; v++) {
+        used = std::max(used, coloring[v] + 1);
+    }
+    return used;
+}
+
+} // namespace
+
+SearchResult exactColoring(const CsrGraph& csr, std::vector<int>& coloring, SolverStats& stats,
+                           const CancellationToken* cancel, long long nodeLimit, ProgressReporter* progress,
+                           Checkpointer* checkpointer) {
+    // Start from a greedy coloring; every search below looks for one color fewer
+    std::vector<int> best(csr.getVertexCount(), -1);
+    greedyColoring(csr, largestDegreeOrder(csr), best);
+    int upper = 0;
+    for (int color : best) {
+        upper = std::max(upper, color + 1);
+    }
+    
+    // A clique needs one color per vertex, so no search below its size can succeed
+    int lower = greedyCliqueSize(csr);
+    
+    // Continue from a checkpoint: its best coloring and bound, and the
+    // interrupted search's path if it was looking for the same color count
+    int startDepth = 0;
+    const char* bestSource = "sf";
+    const SearchCheckpoint* resumed = checkpointer ? checkpointer->getResumed() : nullptr;
+    if (resumed) {
+        if (static_cast<int>(resumed->best.size()) == csr.getVertexCount() &&
+            colorsUsed(resumed->best, csr.getVertexCount()) < upper) {
+            best = resumed->best;
+            upper = colorsUsed(best, csr.getVertexCount());
+            bestSource = "checkpoint";
+        }
+        lower = std::max(lower, resumed->lowerBound);
+        bool pathInRange = static_cast<int>(resumed->exactPath.size()) <= csr.getVertexCount();
+        for (int color : resumed->exactPath) {
+            pathInRange = pathInRange && color >= 0 && color < upper - 1;
+        }
+        if (resumed->exactTarget == upper - 1 && pathInRange) {
+            std::copy(resumed->exactPath.begin(), resumed->exactPath.end(), coloring.begin());
+            startDepth = static_cast<int>(resumed->exactPath.size());
+        }
+    }
+    if (checkpointer) {
+        checkpointer->updateBest(best, lower);
+    }
+    
+    if (progress) {
+        progress->improve(upper, bestSource, 0);
+        progress->raiseLowerBound(lower, "clique", 0);
+    }
+    
+    while (upper > lower) {
+        SearchResult result = exactColoringWithin(csr, upper - 1, coloring, stats, cancel, nodeLimit,
+                                                  checkpointer, startDepth);
+        startDepth = 0;
+        if (result == SearchResult::Found) {
+            best = coloring;
+            upper = 0;
+            for (int color : best) {
+                upper = std::max(upper, color + 1);
+            }
+            if (checkpointer) {
+                checkpointer->updateBest(best, lower);
+            }
+            if (progress) {
+                progress->improve(upper, "exact", stats.nodesExplored);
+            }
+        } else if (result == SearchResult::Infeasible) {
+            lower = upper;
+            if (checkpointer) {
+                checkpointer->updateBest(best, lower);
+            }
+            if (progress) {
+                progress->raiseLowerBound(lower, "exact", stats.nodesExplored);
+            }
+        } else {
+            coloring = best;
+            stats.lowerBound = lower;
+            return SearchResult::Aborted;
+        }
+    }
+    
+    coloring = best;
+    stats.lowerBound = upper;
+    return SearchResult::Found;
+}
+
+SearchResult exactColoringWithin(const CsrGraph& csr, int numColors, std::vector<int>& coloring,
+                                 SolverStats& stats, const CancellationToken* cancel, long long nodeLimit,
+                                 Checkpointer* checkpointer, int startDepth) {
+    int n = csr.getVertexCount();
+    std::fill(coloring.begin() + startDepth, coloring.end(), -1);
+    
+    // Depth-first search over vertices in index order with an explicit stack:
+    // coloring[0..depth) is the current path, so it alone describes the
+    // frontier and can be checkpointed and resumed. usedColors[d] is the
+    // number of colors in use before vertex d.
+    std::vector<int> usedColors(n + 1, 0);
+    for (int d = 0; d < startDepth; d++) {
+        usedColors[d + 1] = std::max(usedColors[d], coloring[d] + 1);
+    }
+    
+    int depth = startDepth;
+    int color = 0;
+    bool entering = true;
+    while (true) {
+        if (entering) {
+            // Base case: all vertices are colored
+            if (depth == n) {
+                return SearchResult::Found;
+            }
+            
+            // Poll every 1024 assignments; reading the clock per node is too slow
+            if ((stats.nodesExplored & 1023) == 0) {
+                if (checkpointer && checkpointer->isDue()) {
+                    checkpointer->updateExact(numColors, coloring, depth);
+                    checkpointer->save();
+                }
+                if (cancel && cancel->isCancelled()) {
+                    if (checkpointer) {
+                        checkpointer->updateExact(numColors, coloring, depth);
+                    }
+                    return SearchResult::Aborted;
+                }
+            }
+            if (nodeLimit > 0 && stats.nodesExplored >= nodeLimit) {
+                if (checkpointer) {
+                    checkpointer->updateExact(numColors, coloring, depth);
+                }
+                return SearchResult::Aborted;
+            }
+            color = 0;
+            entering = false;
+        }
+        
+        // Colors are interchangeable, so a vertex never needs more than one
+        // color beyond those already in use
+        int maxColor = std::min(numColors, usedColors[depth] + 1);
+        while (color < maxColor && !isSafeColor(csr, depth, color, coloring)) {
+            stats.prunedBranches++;
+            color++;
+        }
+        
+        if (color < maxColor) {
+            // Assign the color and descend to the next vertex
+            coloring[depth] = color;
+            stats.nodesExplored++;
+            usedColors[depth + 1] = std::max(usedColors[depth], color + 1);
+            depth++;
+            entering = true;
+            continue;
+        }
+        
+        // No color left for this vertex
+        if (depth == 0) {
+            return SearchResult::Infeasible;
+        }
+        
+        // Backtrack and try the parent's next color
+        depth--;
+        color = coloring[depth] + 1;
+        coloring[depth] = -1;
+        stats.backtracks++;
+    }
+}
+
+} // namespace algorithms
+} // namespace graph_coloring
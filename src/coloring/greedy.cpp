@@ -0,0 +1,109 @@
+#include "../../include/coloring/algorithms.hpp"
+#include <algorithm>
+
+namespace graph_coloring {
+namespace algorithms {
+
+std::vector<int> insertionOrder(const CsrGraph& csr) {
+    std::vector<int> order(csr.getVertexCount());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = static_cast<int>(i);
+    }
+    return order;
+}
+
+std::vector<int> largestDegreeOrder(const CsrGraph& csr) {
+    // Sort vertices by degree in non-increasing order (largest degree first)
+    std::vector<int> order = insertionOrder(csr);
+    std::stable_sort(order.begin(), order.end(), [&csr](int a, int b) {
+        return csr.getDegree(a) > csr.getDegree(b);
+    });
+    return order;
+}
+
+std::vector<int> smallestLastOrder(const CsrGraph& csr) {
+    // Repeatedly remove a vertex of minimum remaining degree (bucket queue,
+    // Batagelj-Zaversnik); coloring in reverse removal order uses at most
+    // degeneracy + 1 colors
+    int n = csr.getVertexCount();
+    std::vector<int> degree(n);
+    int maxDegree = 0;
+    for (int v = 0; v < n; v++) {
+        degree[v] = csr.getDegree(v);
+        maxDegree = std::max(maxDegree, degree[v]);
+    }
+    
+    // Vertices sorted by degree; bin[d] is the first position with degree d
+    std::vector<int> bin(maxDegree + 1, 0);
+    for (int v = 0; v < n; v++) {
+        bin[degree[v]]++;
+    }
+    int start = 0;
+    for (int d = 0; d <= maxDegree; d++) {
+        int count = bin[d];
+        bin[d] = start;
+        start += count;
+    }
+    std::vector<int> sorted(n);
+    std::vector<int> position(n);
+    for (int v = 0; v < n; v++) {
+        position[v] = bin[degree[v]]++;
+        sorted[position[v]] = v;
+    }
+    for (int d = maxDegree; d > 0; d--) {
+        bin[d] = bin[d - 1];
+    }
+    bin[0] = 0;
+    
+    for (int i = 0; i < n; i++) {
+        int v = sorted[i];
+        for (const int* it = csr.neighborsBegin(v); it != csr.neighborsEnd(v); ++it) {
+            int u = *it;
+            if (degree[u] > degree[v]) {
+                // Move u to the front of its bin, then shrink the bin past it
+                int du = degree[u];
+                int pu = position[u];
+                int pw = bin[du];
+                int w = sorted[pw];
+                if (u != w) {
+                    sorted[pu] = w;
+                    position[w] = pu;
+                    sorted[pw] = u;
+                    position[u] = pw;
+                }
+                bin[du]++;
+                degree[u]--;
+            }
+        }
+    }
+    
+    // sorted is now the removal order; color the last removed first
+    std::reverse(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+void greedyColoring(const CsrGraph& csr, const std::vector<int>& order, std::vector<int>& coloring) {
+    // usedBy[c] == v means color c is taken by a neighbor of v; avoids clearing per vertex
+    std::vector<int> usedBy(csr.getVertexCount() + 1, -1);
+    
+    for (int v : order) {
+        for (const int* it = csr.neighborsBegin(v); it != csr.neighborsEnd(v); ++it) {
+            int adjColor = coloring[*it];
+            if (adjColor >= 0) {
+                usedBy[adjColor] = v;
+            }
+        }
+        
+        // Find the first unused color
+        int color = 0;
+        while (usedBy[color] == v) {
+            color++;
+        }
+        
+        // Assign this color to the current vertex
+        coloring[v] = color;
+    }
+}
+
+} // namespace algorithms
+} // namespace graph_coloring
@@ -0,0 +1,287 @@
+#include "../../include/coloring/algorithms.hpp"
+#include "../../include/parallel/thread_pool.hpp"
+#include "../../include/trace/trace.hpp"
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+namespace graph_coloring {
+namespace algorithms {
+
+namespace {
+
+// Largest graph the exact member searches (it still computes the clique bound).
+// The search space grows exponentially with the vertex count, so beyond this
+// it cannot finish within any practical budget and would only hold a worker.
+const int PORTFOLIO_EXACT_MAX_VERTICES = 10000;
+
+// Largest vertices * colors table the local search member allocates
+const long long PORTFOLIO_TABU_MAX_CELLS = 1LL << 26;
+
+// Moves per local search round before it rechecks the shared upper bound
+const long long PORTFOLIO_TABU_ROUND = 20000;
+
+// Best coloring and bounds shared by all members of one portfolio run
+class Incumbent {
+private:
+    mutable std::mutex mutex;
+    std::vector<int> best;
+    std::string bestAlgorithm;
+    std::atomic<int> upper;
+    std::atomic<int> lower;
+    std::atomic<long long> nodesExplored; // Exact member's assignments so far
+    CancellationToken stop; // Cancelled when the bounds meet or the budget runs out
+    ProgressReporter* progress; // Called under the mutex, so never concurrently
+    Checkpointer* checkpointer;
+
+    void stopIfClosed() {
+        if (lower.load() >= upper.load()) {
+            stop.cancel();
+        }
+    }
+
+public:
+    Incumbent(int vertexCount, const CancellationToken* cancel, std::chrono::steady_clock::time_point deadline,
+              ProgressReporter* progress, Checkpointer* checkpointer)
+        : upper(vertexCount + 1), lower(vertexCount > 0 ? 1 : 0), nodesExplored(0),
+          stop(cancel, deadline, true), progress(progress), checkpointer(checkpointer) {
+    }
+
+    const CancellationToken* getStopToken() const { return &stop; }
+    bool isStopped() const { return stop.isCancelled(); }
+    int getUpper() const { return upper.load(); }
+    int getLower() const { return lower.load(); }
+    bool isClosed() const { return lower.load() >= upper.load(); }
+    void setNodesExplored(long long nodes) { nodesExplored.store(nodes); }
+
+    // Keep a complete coloring if it uses fewer colors than the current best
+    void offer(const std::vector<int>& coloring, const char* algorithm) {
+        int colors = 0;
+        for (int color : coloring) {
+            colors = std::max(colors, color + 1);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (colors >= upper.load()) {
+            return;
+        }
+        best = coloring;
+        bestAlgorithm = algorithm;
+        upper.store(colors);
+        if (checkpointer) {
+            checkpointer->updateBest(best, lower.load());
+        }
+        if (progress) {
+            progress->improve(colors, algorithm, nodesExplored.load());
+        }
+        stopIfClosed();
+    }
+
+    void raiseLower(int bound, const char* source) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (bound <= lower.load()) {
+            return;
+        }
+        lower.store(bound);
+        if (checkpointer) {
+            checkpointer->updateBest(best, bound);
+        }
+        if (progress) {
+            progress->raiseLowerBound(bound, source, nodesExplored.load());
+        }
+        stopIfClosed();
+    }
+
+    std::vector<int> getBest() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return best;
+    }
+
+    std::string getBestAlgorithm() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return bestAlgorithm;
+    }
+};
+
+void runGreedy(const CsrGraph& csr, Incumbent& incumbent) {
+    std::vector<int> coloring(csr.getVertexCount(), -1);
+    greedyColoring(csr, insertionOrder(csr), coloring);
+    incumbent.offer(coloring, "greedy");
+}
+
+void runSmallestLast(const CsrGraph& csr, Incumbent& incumbent) {
+    std::vector<int> coloring(csr.getVertexCount(), -1);
+    greedyColoring(csr, smallestLastOrder(csr), coloring);
+    incumbent.offer(coloring, "sl");
+}
+
+void runDsatur(const CsrGraph& csr, Incumbent& incumbent) {
+    std::vector<int> coloring(csr.getVertexCount(), -1);
+    if (dsaturColoring(csr, coloring, incumbent.getStopToken())) {
+        incumbent.offer(coloring, "dsatur");
+    }
+}
+
+void runRlf(const CsrGraph& csr, Incumbent& incumbent) {
+    std::vector<int> coloring(csr.getVertexCount(), -1);
+    if (rlfColoring(csr, coloring, incumbent.getStopToken())) {
+        incumbent.offer(coloring, "rlf");
+    }
+}
+
+// Tabu search for one color fewer than the best coloring found so far
+void runLocalSearch(const CsrGraph& csr, Incumbent& incumbent, Checkpointer* checkpointer) {
+    std::mt19937 rng(12345);
+    std::vector<int> coloring;
+    int target = -1;
+    
+    // Continue the checkpointed round if it was after the same color count
+    const SearchCheckpoint* resumed = checkpointer ? checkpointer->getResumed() : nullptr;
+    if (resumed && resumed->localTarget == incumbent.getUpper() - 1 &&
+        static_cast<int>(resumed->localColoring.size()) == csr.getVertexCount()) {
+        std::istringstream rngState(resumed->localRngState);
+        rngState >> rng;
+        coloring = resumed->localColoring;
+        target = resumed->localTarget;
+    }
+    
+    while (!incumbent.isStopped()) {
+        int k = incumbent.getUpper() - 1;
+        if (k < incumbent.getLower() ||
+            static_cast<long long>(csr.getVertexCount()) * k > PORTFOLIO_TABU_MAX_CELLS) {
+            return;
+        }
+        if (k != target) {
+            // Start from the new best; its highest color class gets recolored at random
+            coloring = incumbent.getBest();
+            target = k;
+        }
+        if (tabuSearch(csr, k, coloring, rng, PORTFOLIO_TABU_ROUND, incumbent.getStopToken())) {
+            incumbent.offer(coloring, "local search");
+        }
+        if (checkpointer) {
+            checkpointer->updateLocalSearch(k, coloring, rng);
+            checkpointer->saveIfDue();
+        }
+    }
+}
+
+// Greedy clique lower bound, then exact searches for one color fewer than the
+// best coloring until one of them proves infeasible
+void runExact(const CsrGraph& csr, Incumbent& incumbent, SolverStats& stats, long long nodeLimit,
+              Checkpointer* checkpointer) {
+    incumbent.raiseLower(greedyCliqueSize(csr), "clique");
+    if (csr.getVertexCount() > PORTFOLIO_EXACT_MAX_VERTICES) {
+        return;
+    }
+
+    std::vector<int> coloring(csr.getVertexCount(), -1);
+    const SearchCheckpoint* resumed = checkpointer ? checkpointer->getResumed() : nullptr;
+    bool first = true;
+    while (!incumbent.isStopped()) {
+        int k = incumbent.getUpper() - 1;
+        if (k < incumbent.getLower()) {
+            return;
+        }
+        
+        // The first search continues the checkpointed one if it had the same target
+        int startDepth = 0;
+        bool pathInRange = first && resumed && static_cast<int>(resumed->exactPath.size()) <= csr.getVertexCount();
+        for (size_t i = 0; pathInRange && i < resumed->exactPath.size(); i++) {
+            pathInRange = resumed->exactPath[i] >= 0 && resumed->exactPath[i] < k;
+        }
+        if (pathInRange && resumed->exactTarget == k) {
+            std::copy(resumed->exactPath.begin(), resumed->exactPath.end(), coloring.begin());
+            startDepth = static_cast<int>(resumed->exactPath.size());
+        }
+        first = false;
+        
+        SearchResult result = exactColoringWithin(csr, k, coloring, stats, incumbent.getStopToken(), nodeLimit,
+                                                  checkpointer, startDepth);
+        incumbent.setNodesExplored(stats.nodesExplored);
+        if (result == SearchResult::Found) {
+            incumbent.offer(coloring, "exact");
+        } else if (result == SearchResult::Infeasible) {
+            incumbent.raiseLower(k + 1, "exact");
+        } else {
+            return;
+        }
+    }
+}
+
+} // namespace
+
+SearchResult portfolioColoring(const CsrGraph& csr, double timeBudgetSeconds, std::vector<int>& coloring,
+                               SolverStats& stats, const CancellationToken* cancel, long long nodeLimit,
+                               ProgressReporter* progress, Checkpointer* checkpointer) {
+    GC_TRACE_SCOPE("portfolio");
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(timeBudgetSeconds));
+
+    SolverStats exactStats;
+    std::vector<std::pair<const char*, std::function<void(Incumbent&)>>> members = {
+        {"sl", [&csr](Incumbent& incumbent) { runSmallestLast(csr, incumbent); }},
+        {"dsatur", [&csr](Incumbent& incumbent) { runDsatur(csr, incumbent); }},
+        {"rlf", [&csr](Incumbent& incumbent) { runRlf(csr, incumbent); }},
+        {"local search", [&csr, checkpointer](Incumbent& incumbent) {
+            runLocalSearch(csr, incumbent, checkpointer);
+        }},
+        {"exact", [&csr, &exactStats, nodeLimit, checkpointer](Incumbent& incumbent) {
+            runExact(csr, incumbent, exactStats, nodeLimit, checkpointer);
+        }},
+    };
+
+    // Greedy runs first on the calling thread, so the others always have a
+    // coloring to improve on
+    Incumbent incumbent(csr.getVertexCount(), cancel, deadline, progress, checkpointer);
+    runGreedy(csr, incumbent);
+    
+    // A checkpoint's best coloring and bound replace greedy's if they are better
+    const SearchCheckpoint* resumed = checkpointer ? checkpointer->getResumed() : nullptr;
+    if (resumed) {
+        if (static_cast<int>(resumed->best.size()) == csr.getVertexCount()) {
+            incumbent.offer(resumed->best, "checkpoint");
+        }
+        incumbent.raiseLower(resumed->lowerBound, "checkpoint");
+    }
+
+    // Every member returns once the bounds meet or the deadline passes, so
+    // waiting (and helping) on the group is enough, even from a pool worker.
+    // The quick heuristics must be taken before the open-ended searches, or
+    // with few threads they only run once the searches give up. A pool
+    // worker's tasks go on its own deque, where it pops the newest first
+    // while idle workers steal the oldest, so it submits last to first;
+    // any other thread submits to the FIFO injection queue in order.
+    auto runMember = [&incumbent](const std::pair<const char*, std::function<void(Incumbent&)>>& member) {
+        GC_TRACE_SCOPE(member.first);
+        member.second(incumbent);
+    };
+    TaskGroup group;
+    if (ThreadPool::currentWorkerIndex() >= 0) {
+        for (auto member = members.rbegin(); member != members.rend(); ++member) {
+            group.run([&runMember, &member = *member]() { runMember(member); });
+        }
+    } else {
+        for (const auto& member : members) {
+            group.run([&runMember, &member]() { runMember(member); });
+        }
+    }
+    group.wait();
+
+    stats.nodesExplored += exactStats.nodesExplored;
+    stats.backtracks += exactStats.backtracks;
+    stats.prunedBranches += exactStats.prunedBranches;
+    stats.lowerBound = incumbent.getLower();
+    stats.bestAlgorithm = incumbent.getBestAlgorithm();
+
+    // Greedy always offers a coloring first, so best is complete
+    coloring = incumbent.getBest();
+    return incumbent.isClosed() ? SearchResult::Found : SearchResult::Aborted;
+}
+
+} // namespace algorithms
+} // namespace graph_coloring
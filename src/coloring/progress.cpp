@@ -0,0 +1,60 @@
+#include "../../include/coloring/progress.hpp"
+#include <algorithm>
+
+namespace graph_coloring {
+
+const char* progressEventName(ProgressEvent event) {
+    switch (event) {
+        case ProgressEvent::LowerBound:
+            return "lower_bound";
+        case ProgressEvent::Finished:
+            return "finished";
+        case ProgressEvent::Improved:
+        default:
+            return "improved";
+    }
+}
+
+ProgressReporter::ProgressReporter(const ProgressCallback* callback, std::chrono::steady_clock::time_point start)
+    : callback(callback), start(start), colors(0), lowerBound(0) {
+}
+
+void ProgressReporter::emit(ProgressEvent event, const char* source, long long nodesExplored) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    SolveProgress progress;
+    progress.event = event;
+    progress.source = source;
+    progress.colors = colors;
+    progress.lowerBound = lowerBound;
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    progress.elapsedMs = elapsed.count();
+    progress.nodesExplored = nodesExplored;
+    (*callback)(progress);
+}
+
+void ProgressReporter::improve(int newColors, const char* source, long long nodesExplored) {
+    if (colors != 0 && newColors >= colors) {
+        return;
+    }
+    colors = newColors;
+    emit(ProgressEvent::Improved, source, nodesExplored);
+}
+
+void ProgressReporter::raiseLowerBound(int bound, const char* source, long long nodesExplored) {
+    if (bound <= lowerBound) {
+        return;
+    }
+    lowerBound = bound;
+    emit(ProgressEvent::LowerBound, source, nodesExplored);
+}
+
+void ProgressReporter::finish(int finalColors, int finalLowerBound, const char* source, long long nodesExplored) {
+    colors = finalColors;
+    lowerBound = std::max(lowerBound, finalLowerBound);
+    emit(ProgressEvent::Finished, source, nodesExplored);
+}
+
+} // namespace graph_coloring
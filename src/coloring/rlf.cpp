@@ -0,0 +1,83 @@
+#include "../../include/coloring/algorithms.hpp"
+
+namespace graph_coloring {
+namespace algorithms {
+
+bool rlfColoring(const CsrGraph& csr, std::vector<int>& coloring, const CancellationToken* cancel) {
+    // Vertex states while building one color class
+    const char CANDIDATE = 0; // Uncolored and not adjacent to the class
+    const char BLOCKED = 1;   // Uncolored but adjacent to the class
+    const char COLORED = 2;
+    
+    int n = csr.getVertexCount();
+    std::vector<char> state(n, CANDIDATE);
+    std::vector<int> uncoloredDegree(n);  // Neighbors that are still uncolored
+    std::vector<int> blockedNeighbors(n, 0); // Neighbors in BLOCKED, for candidates
+    std::vector<int> uncolored(n);        // Compact list of uncolored vertices
+    for (int v = 0; v < n; v++) {
+        coloring[v] = -1;
+        uncoloredDegree[v] = csr.getDegree(v);
+        uncolored[v] = v;
+    }
+    
+    int color = 0;
+    while (!uncolored.empty()) {
+        // Start the class with the vertex of largest uncolored degree
+        int next = uncolored[0];
+        for (int v : uncolored) {
+            if (uncoloredDegree[v] > uncoloredDegree[next]) {
+                next = v;
+            }
+        }
+        
+        for (int step = 0; next >= 0; step++) {
+            if (cancel && (step & 63) == 0 && cancel->isCancelled()) {
+                return false;
+            }
+            
+            int v = next;
+            coloring[v] = color;
+            state[v] = COLORED;
+            for (const int* it = csr.neighborsBegin(v); it != csr.neighborsEnd(v); ++it) {
+                int u = *it;
+                uncoloredDegree[u]--;
+                if (state[u] == CANDIDATE) {
+                    state[u] = BLOCKED;
+                    for (const int* jt = csr.neighborsBegin(u); jt != csr.neighborsEnd(u); ++jt) {
+                        blockedNeighbors[*jt]++;
+                    }
+                }
+            }
+            
+            // Prefer the candidate sharing the most neighbors with blocked vertices,
+            // so the uncolored graph loses as many edges as possible
+            next = -1;
+            for (int u : uncolored) {
+                if (state[u] != CANDIDATE) {
+                    continue;
+                }
+                if (next < 0 || blockedNeighbors[u] > blockedNeighbors[next] ||
+                    (blockedNeighbors[u] == blockedNeighbors[next] && uncoloredDegree[u] < uncoloredDegree[next])) {
+                    next = u;
+                }
+            }
+        }
+        
+        // Class complete: drop colored vertices and reopen the blocked ones
+        size_t kept = 0;
+        for (int v : uncolored) {
+            if (state[v] != COLORED) {
+                state[v] = CANDIDATE;
+                blockedNeighbors[v] = 0;
+                uncolored[kept++] = v;
+            }
+        }
+        uncolored.resize(kept);
+        color++;
+    }
+    
+    return true;
+}
+
+} // namespace algorithms
+} // namespace graph_coloring
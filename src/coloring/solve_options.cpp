@@ -0,0 +1,21 @@
+#include "../../include/coloring/solve_options.hpp"
+
+namespace graph_coloring {
+
+const char* solveStatusName(SolveStatus status) {
+    switch (status) {
+        case SolveStatus::Optimal:
+            return "optimal";
+        case SolveStatus::TimeLimit:
+            return "time_limit";
+        case SolveStatus::NodeLimit:
+            return "node_limit";
+        case SolveStatus::Cancelled:
+            return "cancelled";
+        case SolveStatus::Complete:
+        default:
+            return "complete";
+    }
+}
+
+} // namespace graph_coloring
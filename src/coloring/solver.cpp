@@ -0,0 +1,160 @@
+#include "../../include/coloring/solver.hpp"
+#include "../../include/coloring/algorithms.hpp"
+#include "../../include/coloring/phase_timer.hpp"
+#include "../../include/graph/validation.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+namespace graph_coloring {
+
+Coloring solveColoring(const CsrGraph& csr, ColoringAlgorithm algorithm, const SolveOptions& options) {
+    GC_TRACE_SCOPE("solveColoring");
+    
+    SolverStats stats;
+    stats.algorithm = coloringAlgorithmName(algorithm);
+    stats.vertices = csr.getVertexCount();
+    stats.edges = csr.getEdgeCount();
+    
+    auto solveStart = std::chrono::steady_clock::now();
+    bool hasDeadline = options.timeLimitSeconds > 0.0;
+    CancellationToken cancel(options.cancellation,
+                             solveStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                 std::chrono::duration<double>(options.timeLimitSeconds)),
+                             hasDeadline);
+    ProgressReporter progress(&options.progress, solveStart);
+    
+    // Only the searches that can run for hours are checkpointed
+    std::unique_ptr<Checkpointer> checkpointer;
+    if (!options.checkpointPath.empty() &&
+        (algorithm == ColoringAlgorithm::Exact || algorithm == ColoringAlgorithm::Portfolio)) {
+        checkpointer = std::make_unique<Checkpointer>(options.checkpointPath, options.checkpointIntervalSeconds,
+                                                      csr, coloringAlgorithmName(algorithm));
+        if (options.resume) {
+            checkpointer->resume();
+        }
+    }
+    
+    std::vector<int> coloring(csr.getVertexCount(), -1);
+    std::vector<int> order;
+    SolveStatus status = SolveStatus::Complete;
+    bool interrupted = false;
+    
+    switch (algorithm) {
+        case ColoringAlgorithm::SF: {
+            {
+                PhaseTimer orderingTimer("ordering", stats.orderingMs);
+                order = algorithms::largestDegreeOrder(csr);
+            }
+            PhaseTimer coloringTimer("coloring", stats.coloringMs);
+            algorithms::greedyColoring(csr, order, coloring);
+            break;
+        }
+        case ColoringAlgorithm::Exact: {
+            PhaseTimer coloringTimer("coloring", stats.coloringMs);
+            if (algorithms::exactColoring(csr, coloring, stats, &cancel, options.nodeLimit, &progress,
+                                          checkpointer.get()) == algorithms::SearchResult::Found) {
+                status = SolveStatus::Optimal;
+            } else {
+                interrupted = true;
+            }
+            break;
+        }
+        case ColoringAlgorithm::SmallestLast: {
+            {
+                PhaseTimer orderingTimer("ordering", stats.orderingMs);
+                order = algorithms::smallestLastOrder(csr);
+            }
+            PhaseTimer coloringTimer("coloring", stats.coloringMs);
+            algorithms::greedyColoring(csr, order, coloring);
+            break;
+        }
+        case ColoringAlgorithm::DSatur: {
+            PhaseTimer coloringTimer("coloring", stats.coloringMs);
+            interrupted = !algorithms::dsaturColoring(csr, coloring, &cancel);
+            break;
+        }
+        case ColoringAlgorithm::RLF: {
+            PhaseTimer coloringTimer("coloring", stats.coloringMs);
+            interrupted = !algorithms::rlfColoring(csr, coloring, &cancel);
+            break;
+        }
+        case ColoringAlgorithm::Portfolio: {
+            PhaseTimer coloringTimer("coloring", stats.coloringMs);
+            double budget = hasDeadline ? options.timeLimitSeconds : DEFAULT_PORTFOLIO_BUDGET_SECONDS;
+            if (algorithms::portfolioColoring(csr, budget, coloring, stats, options.cancellation,
+                                              options.nodeLimit, &progress, checkpointer.get()) ==
+                algorithms::SearchResult::Found) {
+                status = SolveStatus::Optimal;
+            } else {
+                // Members run until the budget, so a node limit never ends a portfolio
+                bool cancelled = options.cancellation && options.cancellation->isCancelled();
+                status = cancelled ? SolveStatus::Cancelled : SolveStatus::TimeLimit;
+            }
+            break;
+        }
+        case ColoringAlgorithm::Greedy:
+        default: {
+            // Vertices are colored in insertion order
+            {
+                PhaseTimer orderingTimer("ordering", stats.orderingMs);
+                order = algorithms::insertionOrder(csr);
+            }
+            PhaseTimer coloringTimer("coloring", stats.coloringMs);
+            algorithms::greedyColoring(csr, order, coloring);
+            break;
+        }
+    }
+    
+    if (interrupted) {
+        // Finish what the algorithm left uncolored greedily, so the best
+        // coloring so far is still a complete one
+        std::vector<int> uncolored;
+        for (int v = 0; v < csr.getVertexCount(); v++) {
+            if (coloring[v] < 0) {
+                uncolored.push_back(v);
+            }
+        }
+        algorithms::greedyColoring(csr, uncolored, coloring);
+        
+        if (options.cancellation && options.cancellation->isCancelled()) {
+            status = SolveStatus::Cancelled;
+        } else if (options.nodeLimit > 0 && stats.nodesExplored >= options.nodeLimit) {
+            status = SolveStatus::NodeLimit;
+        } else {
+            status = SolveStatus::TimeLimit;
+        }
+    }
+    stats.status = solveStatusName(status);
+    
+    // A finished search has nothing left to resume; a stopped one saves where it was
+    if (checkpointer) {
+        if (status == SolveStatus::Optimal) {
+            checkpointer->discard();
+        } else {
+            checkpointer->save();
+        }
+    }
+    
+    {
+        PhaseTimer validationTimer("validation", stats.validationMs);
+        ValidationResult validation = validateColoring(csr, coloring);
+        stats.conflicts = validation.conflicts;
+        stats.valid = validation.isValid();
+    }
+    
+    std::chrono::duration<double, std::milli> total = std::chrono::steady_clock::now() - solveStart;
+    stats.totalMs = total.count();
+    stats.solverMemoryBytes = csr.memoryBytes() + (coloring.capacity() + order.capacity()) * sizeof(int);
+    stats.peakRssBytes = currentPeakRssBytes();
+    
+    for (int color : coloring) {
+        stats.colors = std::max(stats.colors, color + 1);
+    }
+    progress.finish(stats.colors, status == SolveStatus::Optimal ? stats.colors : stats.lowerBound,
+                    coloringAlgorithmName(algorithm), stats.nodesExplored);
+    
+    return Coloring(std::move(coloring), algorithm, stats, status);
+}
+
+} // namespace graph_coloring
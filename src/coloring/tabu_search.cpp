@@ -0,0 +1,126 @@
+#include "../../include/coloring/algorithms.hpp"
+
+namespace graph_coloring {
+namespace algorithms {
+
+bool tabuSearch(const CsrGraph& csr, int numColors, std::vector<int>& coloring, std::mt19937& rng,
+                long long maxIterations, const CancellationToken* cancel) {
+    int n = csr.getVertexCount();
+    if (numColors <= 0) {
+        return n == 0;
+    }
+    
+    std::uniform_int_distribution<int> randomColor(0, numColors - 1);
+    for (int v = 0; v < n; v++) {
+        if (coloring[v] < 0 || coloring[v] >= numColors) {
+            coloring[v] = randomColor(rng);
+        }
+    }
+    
+    // adjacentColors[v * k + c]: neighbors of v that currently have color c
+    std::vector<int> adjacentColors(static_cast<size_t>(n) * numColors, 0);
+    long long conflicts = 0;
+    for (int v = 0; v < n; v++) {
+        for (const int* it = csr.neighborsBegin(v); it != csr.neighborsEnd(v); ++it) {
+            adjacentColors[static_cast<size_t>(v) * numColors + coloring[*it]]++;
+        }
+        conflicts += adjacentColors[static_cast<size_t>(v) * numColors + coloring[v]];
+    }
+    conflicts /= 2;
+    
+    // Vertices with at least one conflict, with their position for O(1) removal
+    std::vector<int> conflicting;
+    std::vector<int> conflictPosition(n, -1);
+    auto updateConflicting = [&](int v) {
+        bool inConflict = adjacentColors[static_cast<size_t>(v) * numColors + coloring[v]] > 0;
+        if (inConflict && conflictPosition[v] < 0) {
+            conflictPosition[v] = static_cast<int>(conflicting.size());
+            conflicting.push_back(v);
+        } else if (!inConflict && conflictPosition[v] >= 0) {
+            int last = conflicting.back();
+            conflicting[conflictPosition[v]] = last;
+            conflictPosition[last] = conflictPosition[v];
+            conflicting.pop_back();
+            conflictPosition[v] = -1;
+        }
+    };
+    for (int v = 0; v < n; v++) {
+        updateConflicting(v);
+    }
+    
+    // tabuUntil[v * k + c]: iteration until which moving v back to c is forbidden
+    std::vector<long long> tabuUntil(static_cast<size_t>(n) * numColors, 0);
+    std::uniform_int_distribution<int> tenureJitter(0, 9);
+    long long bestConflicts = conflicts;
+    
+    for (long long iteration = 1; conflicts > 0 && iteration <= maxIterations; iteration++) {
+        if (cancel && (iteration & 255) == 0 && cancel->isCancelled()) {
+            return false;
+        }
+        
+        // Best non-tabu move of a conflicting vertex; tabu moves are allowed
+        // when they beat the best state seen (aspiration)
+        int bestVertex = -1;
+        int bestColor = -1;
+        int bestDelta = 0;
+        int ties = 0;
+        for (int v : conflicting) {
+            const int* counts = adjacentColors.data() + static_cast<size_t>(v) * numColors;
+            int current = counts[coloring[v]];
+            for (int c = 0; c < numColors; c++) {
+                if (c == coloring[v]) {
+                    continue;
+                }
+                int delta = counts[c] - current;
+                bool tabu = tabuUntil[static_cast<size_t>(v) * numColors + c] >= iteration;
+                if (tabu && conflicts + delta >= bestConflicts) {
+                    continue;
+                }
+                if (bestVertex < 0 || delta < bestDelta) {
+                    bestVertex = v;
+                    bestColor = c;
+                    bestDelta = delta;
+                    ties = 1;
+                } else if (delta == bestDelta && std::uniform_int_distribution<int>(0, ties++)(rng) == 0) {
+                    // Reservoir sampling picks uniformly among equal moves
+                    bestVertex = v;
+                    bestColor = c;
+                }
+            }
+        }
+        
+        if (bestVertex < 0) {
+            // Every move is tabu; pick a random conflicting vertex and color
+            bestVertex = conflicting[std::uniform_int_distribution<size_t>(0, conflicting.size() - 1)(rng)];
+            bestColor = randomColor(rng);
+            if (bestColor == coloring[bestVertex]) {
+                continue;
+            }
+            const int* counts = adjacentColors.data() + static_cast<size_t>(bestVertex) * numColors;
+            bestDelta = counts[bestColor] - counts[coloring[bestVertex]];
+        }
+        
+        int oldColor = coloring[bestVertex];
+        coloring[bestVertex] = bestColor;
+        conflicts += bestDelta;
+        tabuUntil[static_cast<size_t>(bestVertex) * numColors + oldColor] =
+            iteration + static_cast<long long>(0.6 * conflicts) + tenureJitter(rng);
+        
+        for (const int* it = csr.neighborsBegin(bestVertex); it != csr.neighborsEnd(bestVertex); ++it) {
+            int u = *it;
+            adjacentColors[static_cast<size_t>(u) * numColors + oldColor]--;
+            adjacentColors[static_cast<size_t>(u) * numColors + bestColor]++;
+            updateConflicting(u);
+        }
+        updateConflicting(bestVertex);
+        
+        if (conflicts < bestConflicts) {
+            bestConflicts = conflicts;
+        }
+    }
+    
+    return conflicts == 0;
+}
+
+} // namespace algorithms
+} // namespace graph_coloring
@@ -0,0 +1,215 @@
+#include "../../include/generators/generators.hpp"
+#include "../../include/parallel/thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace graph_coloring {
+
+namespace {
+
+// Add numVertices vertices evenly spaced on a circle
+void addCircle(Graph& graph, int numVertices, float radius, float angleOffset = 0.0f) {
+    const float centerX = 0.5f;
+    const float centerY = 0.5f;
+    
+    for (int i = 0; i < numVertices; i++) {
+        float angle = 2.0f * M_PI * i / numVertices + angleOffset;
+        graph.addVertex(centerX + radius * cos(angle), centerY + radius * sin(angle));
+    }
+}
+
+} // namespace
+
+Graph GraphGenerator::complete(int numVertices) {
+    Graph graph;
+    addCircle(graph, numVertices, 0.35f);
+    
+    // Connect every vertex to every other vertex
+    for (int i = 0; i < numVertices; i++) {
+        for (int j = i + 1; j < numVertices; j++) {
+            graph.addEdge(i, j);
+        }
+    }
+    
+    return graph;
+}
+
+Graph GraphGenerator::cycle(int numVertices) {
+    Graph graph;
+    addCircle(graph, numVertices, 0.35f);
+    
+    for (int i = 0; i < numVertices; i++) {
+        graph.addEdge(i, (i + 1) % numVertices);
+    }
+    
+    return graph;
+}
+
+Graph GraphGenerator::grid(int rows, int cols) {
+    Graph graph;
+    const float spacingX = 1.0f / (cols + 1);
+    const float spacingY = 1.0f / (rows + 1);
+    
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            graph.addVertex(spacingX * (col + 1), spacingY * (row + 1));
+        }
+    }
+    
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            int currentIndex = row * cols + col;
+            
+            // Connect to right neighbor
+            if (col < cols - 1) {
+                graph.addEdge(currentIndex, currentIndex + 1);
+            }
+            
+            // Connect to bottom neighbor
+            if (row < rows - 1) {
+                graph.addEdge(currentIndex, currentIndex + cols);
+            }
+        }
+    }
+    
+    return graph;
+}
+
+Graph GraphGenerator::star(int numRays) {
+    Graph graph;
+    
+    // Central vertex gets id 0, rays get 1..numRays
+    graph.addVertex(0.5f, 0.5f);
+    addCircle(graph, numRays, 0.4f);
+    
+    for (int i = 1; i <= numRays; i++) {
+        graph.addEdge(0, i);
+    }
+    
+    return graph;
+}
+
+Graph GraphGenerator::petersen() {
+    Graph graph;
+    
+    // Outer pentagon (0-4), inner pentagon offset by half a segment (5-9)
+    addCircle(graph, 5, 0.4f);
+    addCircle(graph, 5, 0.2f, M_PI / 5);
+    
+    for (int i = 0; i < 5; i++) {
+        graph.addEdge(i, (i + 1) % 5);           // Outer cycle
+        graph.addEdge(i, i + 5);                 // Spokes
+        graph.addEdge(5 + i, 5 + ((i + 2) % 5)); // Inner star
+    }
+    
+    return graph;
+}
+
+Graph GraphGenerator::random(int numVertices, double edgeProbability, uint32_t seed) {
+    Graph graph;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(0.0f, 1.0f);
+    
+    for (int i = 0; i < numVertices; i++) {
+        float x = position(rng);
+        float y = position(rng);
+        graph.addVertex(x, y);
+    }
+    
+    if (edgeProbability <= 0.0) {
+        return graph;
+    }
+    
+    // Geometric skipping visits only the pairs that become edges (Batagelj-Brandes)
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double logq = std::log(1.0 - std::min(edgeProbability, 1.0 - 1e-12));
+    long long v = 1;
+    long long w = -1;
+    while (v < numVertices) {
+        w += 1 + static_cast<long long>(std::floor(std::log(1.0 - uniform(rng)) / logq));
+        while (w >= v && v < numVertices) {
+            w -= v;
+            v++;
+        }
+        if (v < numVertices) {
+            graph.addEdge(static_cast<int>(v), static_cast<int>(w));
+        }
+    }
+    
+    return graph;
+}
+
+Graph GraphGenerator::randomGeometric(int numVertices, double radius, uint32_t seed) {
+    Graph graph;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(0.0f, 1.0f);
+    
+    for (int i = 0; i < numVertices; i++) {
+        float x = position(rng);
+        float y = position(rng);
+        graph.addVertex(x, y);
+    }
+    
+    // Bucket vertices into cells of size radius so only neighboring cells are compared
+    int cells = std::max(1, static_cast<int>(1.0 / radius));
+    std::vector<std::vector<int>> buckets(cells * cells);
+    std::vector<Vertex>& vertices = graph.getVertices();
+    auto cellOf = [cells](float coordinate) {
+        return std::min(cells - 1, static_cast<int>(coordinate * cells));
+    };
+    for (const auto& vertex : vertices) {
+        buckets[cellOf(vertex.getY()) * cells + cellOf(vertex.getX())].push_back(vertex.getId());
+    }
+    
+    // Distance checks run in parallel blocks of vertices; edges are then added
+    // block by block, so the edge order does not depend on the thread count
+    const size_t BLOCK = 4096;
+    size_t blocks = (vertices.size() + BLOCK - 1) / BLOCK;
+    std::vector<std::vector<std::pair<int, int>>> blockEdges(blocks);
+    double radiusSquared = radius * radius;
+    parallelFor(0, blocks, 1, [&](size_t firstBlock, size_t lastBlock) {
+        for (size_t block = firstBlock; block < lastBlock; block++) {
+            size_t end = std::min(vertices.size(), (block + 1) * BLOCK);
+            for (size_t i = block * BLOCK; i < end; i++) {
+                const Vertex& vertex = vertices[i];
+                int cellX = cellOf(vertex.getX());
+                int cellY = cellOf(vertex.getY());
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        int nx = cellX + dx;
+                        int ny = cellY + dy;
+                        if (nx < 0 || ny < 0 || nx >= cells || ny >= cells) {
+                            continue;
+                        }
+                        for (int otherId : buckets[ny * cells + nx]) {
+                            if (otherId <= vertex.getId()) {
+                                continue;
+                            }
+                            const Vertex& other = vertices[otherId];
+                            double ddx = other.getX() - vertex.getX();
+                            double ddy = other.getY() - vertex.getY();
+                            if (ddx * ddx + ddy * ddy <= radiusSquared) {
+                                blockEdges[block].emplace_back(vertex.getId(), otherId);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    });
+    
+    for (const auto& edges : blockEdges) {
+        for (const auto& edge : edges) {
+            graph.addEdge(edge.first, edge.second);
+        }
+    }
+    
+    return graph;
+}
+
+} // namespace graph_coloring
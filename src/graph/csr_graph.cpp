@@ -0,0 +1,61 @@
+#include "../../include/graph/csr_graph.hpp"
+#include "../../include/graph/graph.hpp"
+#include <numeric>
+
+namespace graph_coloring {
+
+CsrGraph::CsrGraph() : offsets(1, 0) {
+}
+
+CsrGraph::CsrGraph(const Graph& graph) {
+    const std::vector<Vertex>& vertices = graph.getVertices();
+    const std::vector<Edge>& edges = graph.getEdges();
+    const int n = static_cast<int>(vertices.size());
+    
+    vertexIds.reserve(n);
+    for (const auto& vertex : vertices) {
+        vertexIds.push_back(vertex.getId());
+    }
+    
+    // Translate edge endpoints to dense indices once
+    edgeSources.resize(edges.size());
+    edgeTargets.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        edgeSources[i] = graph.getVertexIndex(edges[i].getSourceId());
+        edgeTargets[i] = graph.getVertexIndex(edges[i].getTargetId());
+    }
+    buildAdjacency(n);
+}
+
+CsrGraph::CsrGraph(int vertexCount, std::vector<int> edgeSources, std::vector<int> edgeTargets)
+    : vertexIds(vertexCount), edgeSources(std::move(edgeSources)), edgeTargets(std::move(edgeTargets)) {
+    std::iota(vertexIds.begin(), vertexIds.end(), 0);
+    buildAdjacency(vertexCount);
+}
+
+void CsrGraph::buildAdjacency(int n) {
+    offsets.assign(n + 1, 0);
+    for (size_t i = 0; i < edgeSources.size(); i++) {
+        offsets[edgeSources[i] + 1]++;
+        offsets[edgeTargets[i] + 1]++;
+    }
+    
+    // Prefix sum of degrees gives each vertex its slice of the neighbor array
+    for (int i = 0; i < n; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    
+    neighbors.resize(offsets[n]);
+    std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < edgeSources.size(); i++) {
+        neighbors[cursor[edgeSources[i]]++] = edgeTargets[i];
+        neighbors[cursor[edgeTargets[i]]++] = edgeSources[i];
+    }
+}
+
+size_t CsrGraph::memoryBytes() const {
+    return (offsets.capacity() + neighbors.capacity() + vertexIds.capacity() +
+            edgeSources.capacity() + edgeTargets.capacity()) * sizeof(int);
+}
+
+} // namespace graph_coloring
@@ -1,39 +1,60 @@
 #include "../../include/graph/graph.hpp"
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <random>
 #include <ctime>
 #include <iostream>
+#include <chrono>
+#include "../../include/trace/trace.hpp"
+#include "../../include/coloring/solver.hpp"
+#include "../../include/coloring/phase_timer.hpp"
 
 namespace graph_coloring {
 
-Graph::Graph() {
+Graph::Graph()
+    : verbose(true), structureVersion(nextVersion()), positionVersion(nextVersion()), colorVersion(nextVersion()) {
 }
 
 Graph::~Graph() {
 }
 
+long long Graph::edgeKey(int sourceId, int targetId) {
+    // Order the endpoints so (a, b) and (b, a) map to the same key
+    long long low = std::min(sourceId, targetId);
+    long long high = std::max(sourceId, targetId);
+    return (low << 32) | (high & 0xffffffffLL);
+}
+
+unsigned long long Graph::nextVersion() {
+    static std::atomic<unsigned long long> counter(1);
+    return counter++;
+}
+
+void Graph::markPositionsChanged() {
+    positionVersion = nextVersion();
+}
+
 void Graph::addVertex(const Vertex& vertex) {
     // Check if a vertex with the same ID already exists
-    for (const auto& v : vertices) {
-        if (v.getId() == vertex.getId()) {
-            return; // Vertex with this ID already exists
-        }
+    if (vertexIndex.find(vertex.getId()) != vertexIndex.end()) {
+        return; // Vertex with this ID already exists
     }
+    vertexIndex[vertex.getId()] = vertices.size();
     vertices.push_back(vertex);
+    structureVersion = nextVersion();
+    positionVersion = nextVersion();
 }
 
 void Graph::addVertex(float x, float y) {
     int id = vertices.size();
-    Vertex vertex(id, x, y);
-    vertices.push_back(vertex);
+    addVertex(Vertex(id, x, y));
 }
 
 Vertex* Graph::getVertex(int id) {
-    for (auto& vertex : vertices) {
-        if (vertex.getId() == id) {
-            return &vertex;
-        }
+    auto it = vertexIndex.find(id);
+    if (it != vertexIndex.end()) {
+        return &vertices[it->second];
     }
     return nullptr;
 }
@@ -42,30 +63,31 @@ std::vector<Vertex>& Graph::getVertices() {
     return vertices;
 }
 
+const std::vector<Vertex>& Graph::getVertices() const {
+    return vertices;
+}
+
+int Graph::getVertexIndex(int id) const {
+    auto it = vertexIndex.find(id);
+    return it != vertexIndex.end() ? static_cast<int>(it->second) : -1;
+}
+
 void Graph::addEdge(const Edge& edge) {
     // Check if vertices exist
-    bool sourceExists = false;
-    bool targetExists = false;
-    
-    for (const auto& v : vertices) {
-        if (v.getId() == edge.getSourceId()) sourceExists = true;
-        if (v.getId() == edge.getTargetId()) targetExists = true;
-        
-        if (sourceExists && targetExists) break;
-    }
+    bool sourceExists = vertexIndex.find(edge.getSourceId()) != vertexIndex.end();
+    bool targetExists = vertexIndex.find(edge.getTargetId()) != vertexIndex.end();
     
     if (!sourceExists || !targetExists) {
         throw std::runtime_error("Cannot add edge: one or both vertices don't exist");
     }
     
     // Check if the edge already exists
-    for (const auto& e : edges) {
-        if (e == edge) {
-            return; // Edge already exists
-        }
+    if (!edgeKeys.insert(edgeKey(edge.getSourceId(), edge.getTargetId())).second) {
+        return; // Edge already exists
     }
     
     edges.push_back(edge);
+    structureVersion = nextVersion();
 }
 
 void Graph::addEdge(int sourceId, int targetId) {
@@ -74,6 +96,9 @@ void Graph::addEdge(int sourceId, int targetId) {
 }
 
 Edge* Graph::getEdge(int sourceId, int targetId) {
+    if (edgeKeys.find(edgeKey(sourceId, targetId)) == edgeKeys.end()) {
+        return nullptr;
+    }
     for (auto& edge : edges) {
         if (edge.connects(sourceId, targetId)) {
             return &edge;
@@ -86,6 +111,10 @@ std::vector<Edge>& Graph::getEdges() {
     return edges;
 }
 
+const std::vector<Edge>& Graph::getEdges() const {
+    return edges;
+}
+
 std::vector<int> Graph::getAdjacentVertexIds(int vertexId) {
     std::vector<int> adjacentIds;
     
@@ -100,144 +129,131 @@ std::vector<int> Graph::getAdjacentVertexIds(int vertexId) {
     return adjacentIds;
 }
 
-void Graph::colorGraph(ColoringAlgorithm algorithm) {
-    // Clear existing coloring
-    vertexColors.clear();
-    
-    // If no vertices, return
-    if (vertices.empty()) {
-        return;
-    }
-    
-    // Choose the algorithm based on the parameter
-    switch (algorithm) {
-        case ColoringAlgorithm::SF:
-            std::cout << "Using smallest-first algorithm for graph coloring" << std::endl;
-            sfColoring();
-            break;
-        case ColoringAlgorithm::Exact:
-            std::cout << "Using exact algorithm for graph coloring" << std::endl;
-            exactColoring();
-            break;
-        case ColoringAlgorithm::Greedy:
-        default:
-            std::cout << "Using greedy algorithm for graph coloring" << std::endl;
-            greedyColoring();
-            break;
+std::vector<int> Graph::getEdgeEndpoints() const {
+    std::vector<int> endpoints;
+    endpoints.reserve(edges.size() * 2);
+    for (const auto& edge : edges) {
+        int source = getVertexIndex(edge.getSourceId());
+        int target = getVertexIndex(edge.getTargetId());
+        if (source >= 0 && target >= 0) {
+            endpoints.push_back(source);
+            endpoints.push_back(target);
+        }
     }
+    return endpoints;
 }
 
-void Graph::greedyColoring() {
-    // Greedy coloring algorithm
-    for (const auto& vertex : vertices) {
-        int vertexId = vertex.getId();
-        
-        // Get colors of adjacent vertices
-        std::vector<int> adjacentIds = getAdjacentVertexIds(vertexId);
-        std::vector<bool> usedColors(vertices.size(), false);
-        
-        for (int adjId : adjacentIds) {
-            auto it = vertexColors.find(adjId);
-            if (it != vertexColors.end()) {
-                int adjColor = it->second;
-                if (adjColor < usedColors.size()) {
-                    usedColors[adjColor] = true;
-                }
-            }
-        }
-        
-        // Find the first unused color
-        int color = 0;
-        for (; color < usedColors.size(); color++) {
-            if (!usedColors[color]) {
+void Graph::colorGraph(ColoringAlgorithm algorithm, const SolveOptions& options) {
+    GC_TRACE_SCOPE("Graph::colorGraph");
+    
+    if (verbose) {
+        switch (algorithm) {
+            case ColoringAlgorithm::SF:
+                std::cout << "Using smallest-first algorithm for graph coloring" << std::endl;
                 break;
-            }
+            case ColoringAlgorithm::Exact:
+                std::cout << "Using exact algorithm for graph coloring" << std::endl;
+                break;
+            case ColoringAlgorithm::SmallestLast:
+                std::cout << "Using smallest-last algorithm for graph coloring" << std::endl;
+                break;
+            case ColoringAlgorithm::DSatur:
+                std::cout << "Using DSATUR algorithm for graph coloring" << std::endl;
+                break;
+            case ColoringAlgorithm::RLF:
+                std::cout << "Using recursive largest first algorithm for graph coloring" << std::endl;
+                break;
+            case ColoringAlgorithm::Portfolio:
+                std::cout << "Using portfolio of all algorithms for graph coloring" << std::endl;
+                break;
+            case ColoringAlgorithm::Greedy:
+            default:
+                std::cout << "Using greedy algorithm for graph coloring" << std::endl;
+                break;
+        }
+    }
+    
+    Coloring coloring = computeColoring(algorithm, options);
+    applyColoring(coloring);
+    lastStats = coloring.getStats();
+    
+    if (algorithm == ColoringAlgorithm::Exact && verbose && !vertices.empty()) {
+        if (coloring.getStatus() == SolveStatus::Optimal) {
+            std::cout << "Found exact coloring with " << lastStats.colors << " colors" << std::endl;
+        } else {
+            std::cout << "Exact search stopped (" << lastStats.status << "); best coloring uses "
+                      << lastStats.colors << " colors, lower bound " << lastStats.lowerBound << std::endl;
         }
-        
-        // Assign this color to the current vertex
-        vertexColors[vertexId] = color;
+    }
+    
+    if (algorithm == ColoringAlgorithm::Portfolio && verbose && !vertices.empty()) {
+        std::cout << "Best coloring uses " << lastStats.colors << " colors (found by "
+                  << lastStats.bestAlgorithm << "), lower bound " << lastStats.lowerBound << std::endl;
     }
 }
 
-void Graph::sfColoring() {
-    // Smallest-First (SF) coloring algorithm
-    // First, compute the degree of each vertex
-    std::vector<std::pair<int, int>> vertexDegrees; // (vertex id, degree)
-    
-    for (const auto& vertex : vertices) {
-        int vertexId = vertex.getId();
-        std::vector<int> adjacentIds = getAdjacentVertexIds(vertexId);
-        vertexDegrees.push_back(std::make_pair(vertexId, adjacentIds.size()));
+Coloring Graph::computeColoring(ColoringAlgorithm algorithm, const SolveOptions& options) const {
+    // If no vertices, there is nothing to solve
+    if (vertices.empty()) {
+        SolverStats stats;
+        stats.algorithm = coloringAlgorithmName(algorithm);
+        stats.status = solveStatusName(SolveStatus::Optimal);
+        stats.valid = true;
+        return Coloring(std::vector<int>(), algorithm, stats, SolveStatus::Optimal);
     }
     
-    // Sort vertices by degree in non-increasing order (largest degree first)
-    std::sort(vertexDegrees.begin(), vertexDegrees.end(), 
-              [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
-                  return a.second > b.second;
-              });
+    auto start = std::chrono::steady_clock::now();
     
-    // Color the vertices in this order
-    for (const auto& vertexPair : vertexDegrees) {
-        int vertexId = vertexPair.first;
-        
-        // Get colors of adjacent vertices
-        std::vector<int> adjacentIds = getAdjacentVertexIds(vertexId);
-        std::vector<bool> usedColors(vertices.size(), false);
-        
-        for (int adjId : adjacentIds) {
-            auto it = vertexColors.find(adjId);
-            if (it != vertexColors.end()) {
-                int adjColor = it->second;
-                if (adjColor < usedColors.size()) {
-                    usedColors[adjColor] = true;
-                }
-            }
-        }
-        
-        // Find the first unused color
-        int color = 0;
-        for (; color < usedColors.size(); color++) {
-            if (!usedColors[color]) {
-                break;
-            }
-        }
-        
-        // Assign this color to the current vertex
-        vertexColors[vertexId] = color;
-    }
+    // Build the adjacency once; the solver only reads it
+    double buildAdjacencyMs = 0.0;
+    PhaseTimer adjacencyTimer("build adjacency", buildAdjacencyMs);
+    CsrGraph csr(*this);
+    adjacencyTimer.stop();
+    
+    Coloring result = solveColoring(csr, algorithm, options);
+    
+    SolverStats stats = result.getStats();
+    stats.buildAdjacencyMs = buildAdjacencyMs;
+    std::chrono::duration<double, std::milli> total = std::chrono::steady_clock::now() - start;
+    stats.totalMs = total.count();
+    return Coloring(result, stats);
 }
 
-void Graph::applyColoring(const std::vector<int>& coloring) {
-    // Apply the coloring to the graph
+void Graph::applyColoring(const Coloring& coloring) {
+    if (coloring.getVertexCount() != static_cast<int>(vertices.size())) {
+        throw std::runtime_error("Cannot apply coloring: vertex count doesn't match the graph");
+    }
+    
+    // Apply the coloring to the graph; uncolored vertices (-1) are left out
     vertexColors.clear();
+    colorVersion = nextVersion();
     
     for (size_t i = 0; i < vertices.size(); i++) {
-        vertexColors[vertices[i].getId()] = coloring[i];
+        int color = coloring.getColor(static_cast<int>(i));
+        if (color >= 0) {
+            vertexColors[vertices[i].getId()] = color;
+        }
     }
 }
 
 bool Graph::isValidColoring() {
     // Check if every adjacent pair has different colors
-    for (const auto& edge : edges) {
-        int sourceId = edge.getSourceId();
-        int targetId = edge.getTargetId();
-        
-        // Both vertices should have colors assigned
-        if (vertexColors.find(sourceId) == vertexColors.end() ||
-            vertexColors.find(targetId) == vertexColors.end()) {
-            return false;
-        }
-        
-        // Colors should be different
-        if (vertexColors[sourceId] == vertexColors[targetId]) {
-            return false;
-        }
+    return validateColoring().isValid();
+}
+
+ValidationResult Graph::validateColoring(bool collectConflicts) {
+    CsrGraph csr(*this);
+    
+    // Dense colors in CSR index order; -1 for vertices without a color
+    std::vector<int> coloring(vertices.size(), -1);
+    for (size_t i = 0; i < vertices.size(); i++) {
+        coloring[i] = getVertexColor(vertices[i].getId());
     }
     
-    return true;
+    return graph_coloring::validateColoring(csr, coloring, collectConflicts);
 }
 
-int Graph::getVertexColor(int vertexId) {
+int Graph::getVertexColor(int vertexId) const {
     auto it = vertexColors.find(vertexId);
     if (it != vertexColors.end()) {
         return it->second;
@@ -252,6 +268,7 @@ void Graph::setVertexColor(int vertexId, int color) {
     }
     
     vertexColors[vertexId] = color;
+    colorVersion = nextVersion();
 }
 
 int Graph::getNumberOfColors() {
@@ -271,6 +288,11 @@ void Graph::clear() {
     vertices.clear();
     edges.clear();
     vertexColors.clear();
+    vertexIndex.clear();
+    edgeKeys.clear();
+    structureVersion = nextVersion();
+    positionVersion = nextVersion();
+    colorVersion = nextVersion();
 }
 
 bool Graph::isEmpty() {
@@ -285,79 +307,12 @@ int Graph::getEdgeCount() {
     return edges.size();
 }
 
-void Graph::exactColoring() {
-    // Start with minimum possible number of colors (1)
-    int minColors = 1;
-    int maxColors = vertices.size(); // Maximum possible colors needed
-    
-    // Binary search for the minimum number of colors
-    while (minColors < maxColors) {
-        int mid = (minColors + maxColors) / 2;
-        std::vector<int> coloring(vertices.size(), -1);
-        
-        if (exactColoringUtil(coloring, 0, mid)) {
-            maxColors = mid;
-        } else {
-            minColors = mid + 1;
-        }
-    }
-    
-    // Try one final time with the minimum number of colors
-    std::vector<int> finalColoring(vertices.size(), -1);
-    if (exactColoringUtil(finalColoring, 0, minColors)) {
-        applyColoring(finalColoring);
-        std::cout << "Found exact coloring with " << minColors << " colors" << std::endl;
-    } else {
-        std::cout << "Failed to find exact coloring" << std::endl;
-    }
+void Graph::setVerbose(bool verbose) {
+    this->verbose = verbose;
 }
 
-bool Graph::exactColoringUtil(std::vector<int>& coloring, int vertexIndex, int numColors) {
-    // Base case: all vertices are colored
-    if (vertexIndex == vertices.size()) {
-        return true;
-    }
-    
-    // Try all possible colors for the current vertex
-    for (int color = 0; color < numColors; color++) {
-        // Check if it's safe to color the current vertex with this color
-        if (isSafeColor(vertices[vertexIndex].getId(), color, coloring)) {
-            // Assign the color
-            coloring[vertexIndex] = color;
-            
-            // Recursively color the rest of the vertices
-            if (exactColoringUtil(coloring, vertexIndex + 1, numColors)) {
-                return true;
-            }
-            
-            // If coloring doesn't lead to a solution, backtrack
-            coloring[vertexIndex] = -1;
-        }
-    }
-    
-    // If no color can be assigned to this vertex
-    return false;
-}
-
-bool Graph::isSafeColor(int vertexId, int color, const std::vector<int>& coloring) {
-    // Get adjacent vertices
-    std::vector<int> adjacentIds = getAdjacentVertexIds(vertexId);
-    
-    // Check if any adjacent vertex has the same color
-    for (int adjId : adjacentIds) {
-        // Find the index of the adjacent vertex
-        auto it = std::find_if(vertices.begin(), vertices.end(),
-            [adjId](const Vertex& v) { return v.getId() == adjId; });
-        
-        if (it != vertices.end()) {
-            int adjIndex = std::distance(vertices.begin(), it);
-            if (coloring[adjIndex] == color) {
-                return false;
-            }
-        }
-    }
-    
-    return true;
+const SolverStats& Graph::getLastStats() const {
+    return lastStats;
 }
 
 } // namespace graph_coloring
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "../../include/graph/solver_stats.hpp"
+#include <sstream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace graph_coloring {
+
+size_t currentPeakRssBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss); // Already in bytes
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024; // Kilobytes
+#endif
+#endif
+}
+
+std::string SolverStats::toJson() const {
+    std::ostringstream out;
+    out << "{\"algorithm\": \"" << algorithm << "\""
+        << ", \"status\": \"" << status << "\""
+        << ", \"vertices\": " << vertices
+        << ", \"edges\": " << edges
+        << ", \"colors\": " << colors
+        << ", \"conflicts\": " << conflicts
+        << ", \"valid\": " << (valid ? "true" : "false")
+        << ", \"phases_ms\": {\"build_adjacency\": " << buildAdjacencyMs
+        << ", \"ordering\": " << orderingMs
+        << ", \"coloring\": " << coloringMs
+        << ", \"validation\": " << validationMs
+        << ", \"total\": " << totalMs << "}"
+        << ", \"search\": {\"nodes_explored\": " << nodesExplored
+        << ", \"backtracks\": " << backtracks
+        << ", \"pruned_branches\": " << prunedBranches << "}"
+        << ", \"conflicts_per_round\": [";
+    for (size_t i = 0; i < conflictsPerRound.size(); i++) {
+        out << (i == 0 ? "" : ", ") << conflictsPerRound[i];
+    }
+    out << "]"
+        << ", \"portfolio\": {\"lower_bound\": " << lowerBound
+        << ", \"best_algorithm\": \"" << bestAlgorithm << "\"}"
+        << ", \"memory\": {\"solver_bytes\": " << solverMemoryBytes
+        << ", \"peak_rss_bytes\": " << peakRssBytes << "}}";
+    return out.str();
+}
+
+} // namespace graph_coloring
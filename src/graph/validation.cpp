@@ -0,0 +1,140 @@
+#include "../../include/graph/validation.hpp"
+#include "../../include/parallel/thread_pool.hpp"
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define GC_HAVE_AVX2_KERNEL 1
+#endif
+
+namespace graph_coloring {
+
+namespace {
+
+// Below this many edges a single thread is faster than handing chunks to the pool
+const size_t PARALLEL_THRESHOLD = 1 << 16;
+
+struct ChunkResult {
+    long long conflicts = 0;
+    long long uncoloredEdges = 0;
+    std::vector<std::pair<int, int>> conflictEdges;
+};
+
+void validateRangeScalar(const int* sources, const int* targets, const int* colors,
+                         size_t begin, size_t end, bool collect, ChunkResult& result) {
+    long long conflicts = 0;
+    long long uncolored = 0;
+    
+    for (size_t i = begin; i < end; i++) {
+        int a = colors[sources[i]];
+        int b = colors[targets[i]];
+        uncolored += (a < 0) | (b < 0);
+        bool conflict = (a == b) & (a >= 0);
+        conflicts += conflict;
+        if (collect && conflict) {
+            result.conflictEdges.emplace_back(sources[i], targets[i]);
+        }
+    }
+    
+    result.conflicts += conflicts;
+    result.uncoloredEdges += uncolored;
+}
+
+#ifdef GC_HAVE_AVX2_KERNEL
+// Eight edges per iteration: gather both endpoint colors, compare, count mask bits
+__attribute__((target("avx2,popcnt")))
+void validateRangeAvx2(const int* sources, const int* targets, const int* colors,
+                       size_t begin, size_t end, bool collect, ChunkResult& result) {
+    long long conflicts = 0;
+    long long uncolored = 0;
+    size_t i = begin;
+    
+    for (; i + 8 <= end; i += 8) {
+        __m256i sourceIndices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sources + i));
+        __m256i targetIndices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(targets + i));
+        __m256i a = _mm256_i32gather_epi32(colors, sourceIndices, 4);
+        __m256i b = _mm256_i32gather_epi32(colors, targetIndices, 4);
+        
+        // Sign bit of (a | b) is set when either endpoint is uncolored
+        int uncoloredMask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_or_si256(a, b)));
+        // Equal colors, excluding equal negative ones: ~a & (a == b)
+        __m256i equal = _mm256_cmpeq_epi32(a, b);
+        int conflictMask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_andnot_si256(a, equal)));
+        
+        uncolored += _mm_popcnt_u32(static_cast<unsigned>(uncoloredMask));
+        conflicts += _mm_popcnt_u32(static_cast<unsigned>(conflictMask));
+        
+        if (collect && conflictMask) {
+            for (int lane = 0; lane < 8; lane++) {
+                if (conflictMask & (1 << lane)) {
+                    result.conflictEdges.emplace_back(sources[i + lane], targets[i + lane]);
+                }
+            }
+        }
+    }
+    
+    result.conflicts += conflicts;
+    result.uncoloredEdges += uncolored;
+    validateRangeScalar(sources, targets, colors, i, end, collect, result);
+}
+
+bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+    return supported;
+}
+#endif
+
+void validateRange(const int* sources, const int* targets, const int* colors,
+                   size_t begin, size_t end, bool collect, ChunkResult& result) {
+#ifdef GC_HAVE_AVX2_KERNEL
+    if (cpuHasAvx2()) {
+        validateRangeAvx2(sources, targets, colors, begin, end, collect, result);
+        return;
+    }
+#endif
+    validateRangeScalar(sources, targets, colors, begin, end, collect, result);
+}
+
+} // namespace
+
+ValidationResult validateColoring(const CsrGraph& csr, const std::vector<int>& coloring,
+                                  bool collectConflicts, int threads) {
+    const int* sources = csr.getEdgeSources().data();
+    const int* targets = csr.getEdgeTargets().data();
+    const int* colors = coloring.data();
+    const size_t edgeCount = csr.getEdgeSources().size();
+    
+    ThreadPool& pool = ThreadPool::global();
+    if (threads <= 0) {
+        threads = pool.getThreadCount();
+    }
+    size_t chunks = edgeCount < PARALLEL_THRESHOLD ? 1 : std::min<size_t>(threads, edgeCount / (PARALLEL_THRESHOLD / 4));
+    chunks = std::max<size_t>(chunks, 1);
+    
+    // Contiguous chunks keep the conflict list in edge order after concatenation
+    std::vector<ChunkResult> partial(chunks);
+    size_t chunkSize = (edgeCount + chunks - 1) / chunks;
+    auto runChunk = [&](size_t chunk) {
+        size_t begin = std::min(edgeCount, chunk * chunkSize);
+        size_t end = std::min(edgeCount, begin + chunkSize);
+        validateRange(sources, targets, colors, begin, end, collectConflicts, partial[chunk]);
+    };
+    
+    parallelFor(0, chunks, 1, [&](size_t first, size_t last) {
+        for (size_t chunk = first; chunk < last; chunk++) {
+            runChunk(chunk);
+        }
+    }, pool);
+    
+    ValidationResult result;
+    for (auto& chunk : partial) {
+        result.conflicts += chunk.conflicts;
+        result.uncoloredEdges += chunk.uncoloredEdges;
+        result.conflictEdges.insert(result.conflictEdges.end(), chunk.conflictEdges.begin(),
+                                    chunk.conflictEdges.end());
+    }
+    
+    return result;
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,16 @@
+#include "../../include/io/csv.hpp"
+
+namespace graph_coloring {
+
+std::string csvField(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,170 @@
+#include "../../include/io/graph_io.hpp"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace graph_coloring {
+
+Graph GraphLoader::loadFromFile(const std::string& path, GraphFileFormat format) {
+    std::ifstream input(path);
+    if (!input) {
+        throw std::runtime_error("Cannot open graph file: " + path);
+    }
+    
+    if (format == GraphFileFormat::Auto) {
+        format = detectFormat(path);
+    }
+    
+    try {
+        if (format == GraphFileFormat::Dimacs) {
+            return loadDimacs(input);
+        }
+        return loadEdgeList(input);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(path + ": " + e.what());
+    }
+}
+
+GraphFileFormat GraphLoader::detectFormat(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    std::string extension = dot == std::string::npos ? "" : path.substr(dot + 1);
+    
+    if (extension == "col" || extension == "dimacs") {
+        return GraphFileFormat::Dimacs;
+    }
+    if (extension == "txt" || extension == "edges" || extension == "el") {
+        return GraphFileFormat::EdgeList;
+    }
+    
+    // Fall back to sniffing the first non-empty line
+    std::ifstream input(path);
+    std::string line;
+    while (std::getline(input, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        if (line[0] == 'c' || line[0] == 'p') {
+            return GraphFileFormat::Dimacs;
+        }
+        break;
+    }
+    return GraphFileFormat::EdgeList;
+}
+
+Graph GraphLoader::loadDimacs(std::istream& input) {
+    Graph graph;
+    std::string line;
+    int lineNumber = 0;
+    bool haveProblem = false;
+    
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == 'c') {
+            continue; // Comment or blank line
+        }
+        
+        std::istringstream tokens(line);
+        char kind = 0;
+        if (!(tokens >> kind)) {
+            continue; // Whitespace only
+        }
+        
+        if (kind == 'p') {
+            // Problem line: "p edge <vertices> <edges>"
+            std::string type;
+            int numVertices = 0;
+            int numEdges = 0;
+            if (!(tokens >> type >> numVertices >> numEdges) || numVertices < 0) {
+                throw std::runtime_error("malformed problem line " + std::to_string(lineNumber));
+            }
+            // DIMACS vertices are numbered 1..n; keep the original IDs
+            for (int id = 1; id <= numVertices; id++) {
+                graph.addVertex(Vertex(id));
+            }
+            haveProblem = true;
+        } else if (kind == 'e') {
+            int sourceId = 0;
+            int targetId = 0;
+            if (!haveProblem) {
+                throw std::runtime_error("edge before problem line at line " + std::to_string(lineNumber));
+            }
+            if (!(tokens >> sourceId >> targetId)) {
+                throw std::runtime_error("malformed edge at line " + std::to_string(lineNumber));
+            }
+            if (sourceId != targetId) {
+                graph.addEdge(sourceId, targetId);
+            }
+        }
+        // Other line types (n, x, ...) carry no structure we use
+    }
+    
+    if (!haveProblem) {
+        throw std::runtime_error("missing DIMACS problem line");
+    }
+    
+    assignCircularLayout(graph);
+    return graph;
+}
+
+Graph GraphLoader::loadEdgeList(std::istream& input) {
+    Graph graph;
+    std::string line;
+    int lineNumber = 0;
+    
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#' || line[0] == '%') {
+            continue; // Comment or blank line
+        }
+        
+        std::istringstream tokens(line);
+        if ((tokens >> std::ws).eof()) {
+            continue; // Whitespace-only line
+        }
+        
+        // "<u>" is an isolated vertex, "<u> <v>" an edge; anything else,
+        // including trailing text, is an error
+        int sourceId = 0;
+        int targetId = 0;
+        if (!(tokens >> sourceId)) {
+            throw std::runtime_error("malformed edge at line " + std::to_string(lineNumber));
+        }
+        bool isolated = (tokens >> std::ws).eof();
+        if (!isolated && (!(tokens >> targetId) || !(tokens >> std::ws).eof())) {
+            throw std::runtime_error("malformed edge at line " + std::to_string(lineNumber));
+        }
+        
+        graph.addVertex(Vertex(sourceId));
+        if (isolated) {
+            continue;
+        }
+        graph.addVertex(Vertex(targetId));
+        
+        if (sourceId != targetId) {
+            graph.addEdge(sourceId, targetId);
+        }
+    }
+    
+    assignCircularLayout(graph);
+    return graph;
+}
+
+void GraphLoader::assignCircularLayout(Graph& graph) {
+    std::vector<Vertex>& vertices = graph.getVertices();
+    const float centerX = 0.5f;
+    const float centerY = 0.5f;
+    const float radius = 0.45f;
+    
+    for (size_t i = 0; i < vertices.size(); i++) {
+        float angle = 2.0f * M_PI * i / vertices.size();
+        vertices[i].setPosition(centerX + radius * cos(angle), centerY + radius * sin(angle));
+    }
+    graph.markPositionsChanged();
+}
+
+} // namespace graph_coloring
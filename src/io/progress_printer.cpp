@@ -0,0 +1,44 @@
+#include "../../include/io/progress_printer.hpp"
+#include <chrono>
+#include <iostream>
+
+namespace graph_coloring {
+
+ProgressPrinter::ProgressPrinter() : queue(4096), done(false), dropped(0) {
+    thread = std::thread([this]() {
+        while (!done.load()) {
+            drain();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        drain();
+    });
+}
+
+ProgressPrinter::~ProgressPrinter() {
+    done.store(true);
+    thread.join();
+    if (dropped.load() > 0) {
+        std::cerr << "Dropped " << dropped.load() << " progress events" << std::endl;
+    }
+}
+
+void ProgressPrinter::drain() {
+    Line line;
+    while (queue.tryPop(line)) {
+        const SolveProgress& p = line.progress;
+        std::cerr << line.label << ": " << progressEventName(p.event) << " " << p.colors << " colors";
+        if (p.lowerBound > 0) {
+            std::cerr << ", lower bound " << p.lowerBound;
+        }
+        std::cerr << " (" << p.source << ", " << p.elapsedMs << " ms, " << p.nodesExplored << " nodes)"
+                  << std::endl;
+    }
+}
+
+void ProgressPrinter::push(const std::string& label, const SolveProgress& progress) {
+    if (!queue.tryPush(Line{label, progress})) {
+        dropped++;
+    }
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,191 @@
+#include "../../include/io/result_writer.hpp"
+#include "../../include/trace/trace.hpp"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+
+namespace graph_coloring {
+
+namespace {
+
+// Append an integer without going through iostreams
+void appendInt(std::string& buffer, int value) {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+} // namespace
+
+ColoringRecord ColoringRecord::fromGraph(Graph& graph) {
+    ColoringRecord record;
+    const std::vector<Vertex>& vertices = graph.getVertices();
+    record.vertexIds.reserve(vertices.size());
+    record.colors.reserve(vertices.size());
+    
+    for (const auto& vertex : vertices) {
+        record.vertexIds.push_back(vertex.getId());
+        record.colors.push_back(graph.getVertexColor(vertex.getId()));
+    }
+    
+    return record;
+}
+
+std::string ResultWriter::format(const ColoringRecord& record, ResultFormat format) {
+    std::string buffer;
+    
+    switch (format) {
+        case ResultFormat::Binary:
+            buffer.assign(reinterpret_cast<const char*>(record.colors.data()),
+                          record.colors.size() * sizeof(int));
+            break;
+        case ResultFormat::ClassLists: {
+            // Bucket vertex IDs by color, keeping vertex order inside each class
+            int maxColor = -1;
+            for (int color : record.colors) {
+                maxColor = std::max(maxColor, color);
+            }
+            std::vector<std::vector<int>> classes(maxColor + 1);
+            for (size_t i = 0; i < record.colors.size(); i++) {
+                if (record.colors[i] >= 0) {
+                    classes[record.colors[i]].push_back(record.vertexIds[i]);
+                }
+            }
+            
+            for (size_t color = 0; color < classes.size(); color++) {
+                appendInt(buffer, static_cast<int>(color));
+                buffer += ':';
+                for (int id : classes[color]) {
+                    buffer += ' ';
+                    appendInt(buffer, id);
+                }
+                buffer += '\n';
+            }
+            break;
+        }
+        case ResultFormat::Text:
+        default:
+            // Roughly 12 bytes per line is enough for most graphs
+            buffer.reserve(record.colors.size() * 12);
+            for (size_t i = 0; i < record.colors.size(); i++) {
+                appendInt(buffer, record.vertexIds[i]);
+                buffer += ' ';
+                appendInt(buffer, record.colors[i]);
+                buffer += '\n';
+            }
+            break;
+    }
+    
+    return buffer;
+}
+
+void ResultWriter::write(std::ostream& out, const ColoringRecord& record, ResultFormat format) {
+    std::string buffer = ResultWriter::format(record, format);
+    out.write(buffer.data(), buffer.size());
+}
+
+void ResultWriter::writeFile(const std::string& path, const ColoringRecord& record, ResultFormat format) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Cannot write coloring: " + path);
+    }
+    write(out, record, format);
+    if (!out) {
+        throw std::runtime_error("Failed writing coloring: " + path);
+    }
+}
+
+const char* ResultWriter::extension(ResultFormat format) {
+    switch (format) {
+        case ResultFormat::Binary:
+            return ".bin";
+        case ResultFormat::ClassLists:
+            return ".classes";
+        case ResultFormat::Text:
+        default:
+            return ".colors";
+    }
+}
+
+bool ResultWriter::parseFormat(const std::string& name, ResultFormat& format) {
+    if (name == "text") {
+        format = ResultFormat::Text;
+    } else if (name == "binary") {
+        format = ResultFormat::Binary;
+    } else if (name == "classes") {
+        format = ResultFormat::ClassLists;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+AsyncResultWriter::AsyncResultWriter() : pending(0), stopping(false) {
+    worker = std::thread(&AsyncResultWriter::workerLoop, this);
+}
+
+AsyncResultWriter::~AsyncResultWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    worker.join();
+}
+
+void AsyncResultWriter::submit(size_t id, const std::string& path, ColoringRecord record, ResultFormat format) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(Job{id, path, std::move(record), format});
+        pending++;
+    }
+    queueChanged.notify_all();
+}
+
+std::vector<AsyncResultWriter::WriteError> AsyncResultWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    queueChanged.wait(lock, [this]() { return pending == 0; });
+    
+    std::vector<WriteError> failed;
+    failed.swap(errors);
+    return failed;
+}
+
+void AsyncResultWriter::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    
+    while (true) {
+        queueChanged.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            return; // Stopping and nothing left to write
+        }
+        
+        Job job = std::move(queue.front());
+        queue.pop_front();
+        
+        // Do the actual I/O without holding the lock
+        lock.unlock();
+        bool failed = false;
+        std::string message;
+        try {
+            GC_TRACE_SCOPE("async write");
+            ResultWriter::writeFile(job.path, job.record, job.format);
+        } catch (const std::exception& e) {
+            failed = true;
+            message = e.what();
+        } catch (...) {
+            failed = true;
+            message = "unknown write error";
+        }
+        lock.lock();
+        
+        if (failed) {
+            errors.push_back(WriteError{job.id, message});
+        }
+        pending--;
+        queueChanged.notify_all();
+    }
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,453 @@
+#include "../../include/layout/force_layout.hpp"
+#include "../../include/io/graph_io.hpp"
+#include "../../include/layout/multilevel_layout.hpp"
+#include "../../include/parallel/thread_pool.hpp"
+#include "../../include/render/quadtree.hpp"
+#include "../../include/trace/trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define GC_HAVE_AVX2_KERNEL 1
+#endif
+
+namespace graph_coloring {
+
+namespace {
+
+const QuadtreeLimits SPLIT_LIMITS = {32, 32};
+// Leaves and vertices per parallelFor chunk
+const size_t LEAF_GRAIN = 64;
+const size_t VERTEX_GRAIN = 1024;
+
+// ForceAtlas2 speed control
+const float MIN_SPEED_EFFICIENCY = 0.05f;
+const float MAX_JITTER_TOLERANCE = 10.0f;
+const float MAX_SPEED_RISE = 0.5f;
+
+// Sum of mass * (px - x, py - y) / distance^2 over an interaction list:
+// the repulsion direction scaled by 1 / distance. Coincident points add nothing.
+void sumRepulsionScalar(float px, float py, const float* xs, const float* ys, const float* masses,
+                        size_t begin, size_t end, float& sumX, float& sumY) {
+    float accumX = 0.0f;
+    float accumY = 0.0f;
+    for (size_t j = begin; j < end; j++) {
+        float dx = px - xs[j];
+        float dy = py - ys[j];
+        float distanceSquared = dx * dx + dy * dy;
+        float factor = distanceSquared > 0.0f ? masses[j] / distanceSquared : 0.0f;
+        accumX += dx * factor;
+        accumY += dy * factor;
+    }
+    sumX += accumX;
+    sumY += accumY;
+}
+
+#ifdef GC_HAVE_AVX2_KERNEL
+// Eight list entries per iteration
+__attribute__((target("avx2,fma")))
+void sumRepulsionAvx2(float px, float py, const float* xs, const float* ys, const float* masses,
+                      size_t count, float& sumX, float& sumY) {
+    __m256 pointX = _mm256_set1_ps(px);
+    __m256 pointY = _mm256_set1_ps(py);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 accumX = zero;
+    __m256 accumY = zero;
+    size_t j = 0;
+
+    for (; j + 8 <= count; j += 8) {
+        __m256 dx = _mm256_sub_ps(pointX, _mm256_loadu_ps(xs + j));
+        __m256 dy = _mm256_sub_ps(pointY, _mm256_loadu_ps(ys + j));
+        __m256 distanceSquared = _mm256_fmadd_ps(dx, dx, _mm256_mul_ps(dy, dy));
+        // Coincident lanes divide by zero; the mask clears them
+        __m256 factor = _mm256_div_ps(_mm256_loadu_ps(masses + j), distanceSquared);
+        factor = _mm256_and_ps(factor, _mm256_cmp_ps(distanceSquared, zero, _CMP_GT_OQ));
+        accumX = _mm256_fmadd_ps(dx, factor, accumX);
+        accumY = _mm256_fmadd_ps(dy, factor, accumY);
+    }
+
+    float lanesX[8];
+    float lanesY[8];
+    _mm256_storeu_ps(lanesX, accumX);
+    _mm256_storeu_ps(lanesY, accumY);
+    for (int lane = 0; lane < 8; lane++) {
+        sumX += lanesX[lane];
+        sumY += lanesY[lane];
+    }
+    sumRepulsionScalar(px, py, xs, ys, masses, j, count, sumX, sumY);
+}
+
+bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+}
+#endif
+
+void sumRepulsion(float px, float py, const std::vector<float>& xs, const std::vector<float>& ys,
+                  const std::vector<float>& masses, float& sumX, float& sumY) {
+#ifdef GC_HAVE_AVX2_KERNEL
+    if (cpuHasAvx2()) {
+        sumRepulsionAvx2(px, py, xs.data(), ys.data(), masses.data(), xs.size(), sumX, sumY);
+        return;
+    }
+#endif
+    sumRepulsionScalar(px, py, xs.data(), ys.data(), masses.data(), 0, xs.size(), sumX, sumY);
+}
+
+} // namespace
+
+ForceLayout::ForceLayout(const Graph& graph, const ForceLayoutOptions& options)
+    : ForceLayout(CsrGraph(graph), options) {
+}
+
+ForceLayout::ForceLayout(CsrGraph csr, const ForceLayoutOptions& options)
+    : csr(std::move(csr)), options(options), speed(1.0f), speedEfficiency(1.0f), iteration(0), converged(false) {
+    size_t n = static_cast<size_t>(this->csr.getVertexCount());
+    mass.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        mass[i] = static_cast<float>(this->csr.getDegree(static_cast<int>(i)) + 1);
+    }
+    forceX.assign(n, 0.0f);
+    forceY.assign(n, 0.0f);
+    previousForceX.assign(n, 0.0f);
+    previousForceY.assign(n, 0.0f);
+    swinging.assign(n, 0.0f);
+    traction.assign(n, 0.0f);
+    randomizePositions();
+}
+
+void ForceLayout::randomizePositions() {
+    // Spread over a square that grows with the vertex count, about the size
+    // the layout settles at
+    size_t n = mass.size();
+    float side = std::sqrt(static_cast<float>(n)) + 1.0f;
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<float> coordinate(-0.5f * side, 0.5f * side);
+    x.resize(n);
+    y.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        x[i] = coordinate(rng);
+        y[i] = coordinate(rng);
+    }
+}
+
+void ForceLayout::setPositions(const std::vector<float>& x, const std::vector<float>& y) {
+    if (x.size() != mass.size() || y.size() != mass.size()) {
+        throw std::runtime_error("layout positions do not match the vertex count");
+    }
+    this->x = x;
+    this->y = y;
+    converged = false;
+}
+
+void ForceLayout::buildTree() {
+    GC_TRACE_SCOPE("build layout tree");
+
+    size_t n = x.size();
+    float minX = *std::min_element(x.begin(), x.end());
+    float minY = *std::min_element(y.begin(), y.end());
+    float maxX = *std::max_element(x.begin(), x.end());
+    float maxY = *std::max_element(y.begin(), y.end());
+    // Square cells, so a cell's size is comparable with distances in any direction
+    float side = std::max(std::max(maxX - minX, maxY - minY), 1e-6f);
+
+    cells.clear();
+    leaves.clear();
+    bodyOrder.resize(n);
+    std::iota(bodyOrder.begin(), bodyOrder.end(), 0);
+    cells.push_back({minX, minY, side, 0.0f, 0.0f, 0.0f, -1, 0, static_cast<int>(n)});
+    split(0, 0);
+
+    bodyX.resize(n);
+    bodyY.resize(n);
+    bodyMass.resize(n);
+    for (size_t k = 0; k < n; k++) {
+        int i = bodyOrder[k];
+        bodyX[k] = x[i];
+        bodyY[k] = y[i];
+        bodyMass[k] = mass[i];
+    }
+}
+
+void ForceLayout::split(int cell, int depth) {
+    Cell parent = cells[cell];
+    if (SPLIT_LIMITS.splits(parent.bodyEnd - parent.bodyBegin, depth)) {
+        float half = parent.size * 0.5f;
+        float midX = parent.minX + half;
+        float midY = parent.minY + half;
+        int cuts[5];
+        partitionQuadrants(bodyOrder, parent.bodyBegin, parent.bodyEnd, midX, midY,
+                           [&](int v) { return x[v]; }, [&](int v) { return y[v]; }, cuts);
+
+        int firstChild = static_cast<int>(cells.size());
+        cells[cell].firstChild = firstChild;
+        for (int q = 0; q < 4; q++) {
+            cells.push_back({q & 1 ? midX : parent.minX, q & 2 ? midY : parent.minY, half,
+                             0.0f, 0.0f, 0.0f, -1, cuts[q], cuts[q + 1]});
+        }
+
+        float totalMass = 0.0f;
+        float sumX = 0.0f;
+        float sumY = 0.0f;
+        for (int q = 0; q < 4; q++) {
+            split(firstChild + q, depth + 1);
+            const Cell& child = cells[firstChild + q];
+            totalMass += child.mass;
+            sumX += child.massX * child.mass;
+            sumY += child.massY * child.mass;
+        }
+        cells[cell].mass = totalMass;
+        cells[cell].massX = totalMass > 0.0f ? sumX / totalMass : midX;
+        cells[cell].massY = totalMass > 0.0f ? sumY / totalMass : midY;
+        return;
+    }
+
+    if (parent.bodyEnd > parent.bodyBegin) {
+        leaves.push_back(cell);
+    }
+
+    float totalMass = 0.0f;
+    float sumX = 0.0f;
+    float sumY = 0.0f;
+    for (int k = parent.bodyBegin; k < parent.bodyEnd; k++) {
+        int v = bodyOrder[k];
+        totalMass += mass[v];
+        sumX += x[v] * mass[v];
+        sumY += y[v] * mass[v];
+    }
+    cells[cell].mass = totalMass;
+    cells[cell].massX = totalMass > 0.0f ? sumX / totalMass : parent.minX;
+    cells[cell].massY = totalMass > 0.0f ? sumY / totalMass : parent.minY;
+}
+
+void ForceLayout::computeForces() {
+    GC_TRACE_SCOPE("layout forces");
+
+    buildTree();
+    const float thetaSquared = options.theta * options.theta;
+
+    parallelFor(0, leaves.size(), LEAF_GRAIN, [&](size_t first, size_t last) {
+        std::vector<float> listX;
+        std::vector<float> listY;
+        std::vector<float> listMass;
+        std::vector<int> stack;
+
+        for (size_t l = first; l < last; l++) {
+            const Cell& leaf = cells[leaves[l]];
+            float leafMaxX = leaf.minX + leaf.size;
+            float leafMaxY = leaf.minY + leaf.size;
+
+            // Interaction list of the leaf: cells far enough from every point
+            // of it as one point at their center of mass, the vertices of
+            // near leaves (the leaf's own included) one by one
+            listX.clear();
+            listY.clear();
+            listMass.clear();
+            stack.assign(1, 0);
+            while (!stack.empty()) {
+                const Cell& cell = cells[stack.back()];
+                stack.pop_back();
+                if (cell.mass == 0.0f) {
+                    continue;
+                }
+                float dx = std::max(std::max(leaf.minX - cell.massX, cell.massX - leafMaxX), 0.0f);
+                float dy = std::max(std::max(leaf.minY - cell.massY, cell.massY - leafMaxY), 0.0f);
+                if (cell.size * cell.size < thetaSquared * (dx * dx + dy * dy)) {
+                    listX.push_back(cell.massX);
+                    listY.push_back(cell.massY);
+                    listMass.push_back(cell.mass);
+                } else if (cell.firstChild < 0) {
+                    listX.insert(listX.end(), bodyX.begin() + cell.bodyBegin, bodyX.begin() + cell.bodyEnd);
+                    listY.insert(listY.end(), bodyY.begin() + cell.bodyBegin, bodyY.begin() + cell.bodyEnd);
+                    listMass.insert(listMass.end(), bodyMass.begin() + cell.bodyBegin, bodyMass.begin() + cell.bodyEnd);
+                } else {
+                    for (int q = 0; q < 4; q++) {
+                        stack.push_back(cell.firstChild + q);
+                    }
+                }
+            }
+
+            for (int k = leaf.bodyBegin; k < leaf.bodyEnd; k++) {
+                int i = bodyOrder[k];
+                float px = x[i];
+                float py = y[i];
+                float repulsionX = 0.0f;
+                float repulsionY = 0.0f;
+                sumRepulsion(px, py, listX, listY, listMass, repulsionX, repulsionY);
+                float fx = options.scalingRatio * mass[i] * repulsionX;
+                float fy = options.scalingRatio * mass[i] * repulsionY;
+
+                // Edges pull linearly with distance
+                for (const int* neighbor = csr.neighborsBegin(i); neighbor != csr.neighborsEnd(i); neighbor++) {
+                    fx -= px - x[*neighbor];
+                    fy -= py - y[*neighbor];
+                }
+
+                // Gravity toward the origin, independent of distance
+                float distance = std::sqrt(px * px + py * py);
+                if (distance > 0.0f) {
+                    float pull = options.gravity * mass[i] / distance;
+                    fx -= px * pull;
+                    fy -= py * pull;
+                }
+
+                forceX[i] = fx;
+                forceY[i] = fy;
+                float swingX = fx - previousForceX[i];
+                float swingY = fy - previousForceY[i];
+                float tractionX = fx + previousForceX[i];
+                float tractionY = fy + previousForceY[i];
+                swinging[i] = mass[i] * std::sqrt(swingX * swingX + swingY * swingY);
+                traction[i] = mass[i] * 0.5f * std::sqrt(tractionX * tractionX + tractionY * tractionY);
+            }
+        }
+    });
+}
+
+void ForceLayout::moveVertices() {
+    size_t n = x.size();
+    double totalSwinging = 0.0;
+    double totalTraction = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        totalSwinging += swinging[i];
+        totalTraction += traction[i];
+    }
+
+    // Global speed (ForceAtlas2): as fast as the vertices allow without
+    // oscillating more than the jitter tolerance
+    float estimatedJitter = 0.05f * std::sqrt(static_cast<float>(n));
+    float minJitter = std::sqrt(estimatedJitter);
+    float jitter = options.jitterTolerance *
+                   std::max(minJitter, std::min(MAX_JITTER_TOLERANCE,
+                                                static_cast<float>(estimatedJitter * totalTraction / (double(n) * n))));
+    if (totalTraction > 0.0 && totalSwinging / totalTraction > 2.0) {
+        if (speedEfficiency > MIN_SPEED_EFFICIENCY) {
+            speedEfficiency *= 0.5f;
+        }
+        jitter = std::max(jitter, options.jitterTolerance);
+    }
+    float targetSpeed = totalSwinging > 0.0
+                            ? static_cast<float>(jitter * speedEfficiency * totalTraction / totalSwinging)
+                            : speed;
+    if (totalSwinging > jitter * totalTraction) {
+        if (speedEfficiency > MIN_SPEED_EFFICIENCY) {
+            speedEfficiency *= 0.7f;
+        }
+    } else if (speed < 1000.0f) {
+        speedEfficiency *= 1.3f;
+    }
+    speed += std::min(targetSpeed - speed, MAX_SPEED_RISE * speed);
+
+    // Each vertex slows down by how much its own force swings
+    double movement = 0.0;
+    std::mutex movementMutex;
+    parallelFor(0, n, VERTEX_GRAIN, [&](size_t first, size_t last) {
+        double chunkMovement = 0.0;
+        for (size_t i = first; i < last; i++) {
+            float factor = speed / (1.0f + std::sqrt(speed * swinging[i]));
+            float dx = forceX[i] * factor;
+            float dy = forceY[i] * factor;
+            x[i] += dx;
+            y[i] += dy;
+            chunkMovement += std::sqrt(dx * dx + dy * dy);
+        }
+        std::lock_guard<std::mutex> lock(movementMutex);
+        movement += chunkMovement;
+    });
+
+    if (movement / n < options.tolerance * cells[0].size) {
+        converged = true;
+    }
+}
+
+bool ForceLayout::step() {
+    if (x.size() < 2) {
+        converged = true;
+    }
+    if (converged || iteration >= options.maxIterations) {
+        return false;
+    }
+    GC_TRACE_SCOPE("force layout step");
+
+    std::swap(forceX, previousForceX);
+    std::swap(forceY, previousForceY);
+    computeForces();
+    moveVertices();
+    iteration++;
+    return !converged && iteration < options.maxIterations;
+}
+
+void ForceLayout::run() {
+    GC_TRACE_SCOPE("force layout");
+    while (step()) {
+    }
+}
+
+void ForceLayout::apply(Graph& graph) const {
+    applyLayout(graph, x, y);
+}
+
+void applyLayout(Graph& graph, const std::vector<float>& x, const std::vector<float>& y) {
+    std::vector<Vertex>& vertices = graph.getVertices();
+    if (vertices.size() != x.size()) {
+        throw std::runtime_error("graph does not match the layout");
+    }
+    if (vertices.empty()) {
+        return;
+    }
+
+    float minX = *std::min_element(x.begin(), x.end());
+    float minY = *std::min_element(y.begin(), y.end());
+    float width = *std::max_element(x.begin(), x.end()) - minX;
+    float height = *std::max_element(y.begin(), y.end()) - minY;
+    float scale = 1.0f / std::max(std::max(width, height), 1e-6f);
+    // Center the shorter side
+    float offsetX = 0.5f * (1.0f - width * scale);
+    float offsetY = 0.5f * (1.0f - height * scale);
+    for (size_t i = 0; i < vertices.size(); i++) {
+        vertices[i].setPosition((x[i] - minX) * scale + offsetX, (y[i] - minY) * scale + offsetY);
+    }
+    graph.markPositionsChanged();
+}
+
+bool parseLayoutAlgorithm(const std::string& name, LayoutAlgorithm& algorithm) {
+    if (name == "circular") {
+        algorithm = LayoutAlgorithm::Circular;
+    } else if (name == "force") {
+        algorithm = LayoutAlgorithm::Force;
+    } else if (name == "multilevel") {
+        algorithm = LayoutAlgorithm::Multilevel;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void layoutGraph(Graph& graph, LayoutAlgorithm algorithm) {
+    GC_TRACE_SCOPE("layout graph");
+
+    switch (algorithm) {
+        case LayoutAlgorithm::Circular:
+            GraphLoader::assignCircularLayout(graph);
+            break;
+        case LayoutAlgorithm::Force: {
+            ForceLayout layout(graph);
+            layout.run();
+            layout.apply(graph);
+            break;
+        }
+        case LayoutAlgorithm::Multilevel: {
+            MultilevelLayout layout(graph);
+            layout.run();
+            layout.apply(graph);
+            break;
+        }
+    }
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,254 @@
+#include "../../include/layout/multilevel_layout.hpp"
+#include "../../include/render/bounds.hpp"
+#include "../../include/parallel/thread_pool.hpp"
+#include "../../include/trace/trace.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace graph_coloring {
+
+namespace {
+
+// Stop coarsening once a level keeps more than this fraction of the
+// vertices (e.g. many isolated vertices left)
+const float MIN_SHRINK = 0.9f;
+// Edges per parallelFor chunk when building a coarse edge list
+const size_t EDGE_GRAIN = 1 << 16;
+
+// Group the vertices of graph in pairs along edges; each vertex's group
+// goes to parent. Returns the number of groups.
+int matchVertices(const CsrGraph& graph, std::mt19937& rng, std::vector<int>& parent) {
+    int n = graph.getVertexCount();
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    parent.assign(n, -1);
+
+    // Pair each vertex with its unmatched neighbor of lowest degree, which
+    // keeps hubs free to absorb the leftovers below
+    int groups = 0;
+    for (int v : order) {
+        if (parent[v] >= 0) {
+            continue;
+        }
+        int best = -1;
+        int bestDegree = INT_MAX;
+        for (const int* u = graph.neighborsBegin(v); u != graph.neighborsEnd(v); u++) {
+            if (parent[*u] < 0 && graph.getDegree(*u) < bestDegree) {
+                best = *u;
+                bestDegree = graph.getDegree(*u);
+            }
+        }
+        if (best >= 0) {
+            parent[v] = parent[best] = groups++;
+        }
+    }
+
+    // A vertex left unmatched had all its neighbors matched before its turn;
+    // it joins the group of its lowest-degree neighbor (isolated vertices
+    // stay alone), so stars collapse instead of losing one leaf per level
+    for (int v : order) {
+        if (parent[v] >= 0) {
+            continue;
+        }
+        int best = -1;
+        int bestDegree = INT_MAX;
+        for (const int* u = graph.neighborsBegin(v); u != graph.neighborsEnd(v); u++) {
+            if (graph.getDegree(*u) < bestDegree) {
+                best = *u;
+                bestDegree = graph.getDegree(*u);
+            }
+        }
+        parent[v] = best >= 0 ? parent[best] : groups++;
+    }
+    return groups;
+}
+
+// Graph of the groups: one edge between two groups joined by any edge
+CsrGraph buildCoarseGraph(const CsrGraph& graph, const std::vector<int>& parent, int groups) {
+    const std::vector<int>& sources = graph.getEdgeSources();
+    const std::vector<int>& targets = graph.getEdgeTargets();
+    std::vector<long long> keys(sources.size());
+    parallelFor(0, sources.size(), EDGE_GRAIN, [&](size_t first, size_t last) {
+        for (size_t e = first; e < last; e++) {
+            long long a = parent[sources[e]];
+            long long b = parent[targets[e]];
+            // Edges inside a group become -1 and sort to the front
+            keys[e] = a == b ? -1 : (std::min(a, b) << 32) | std::max(a, b);
+        }
+    });
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<int> coarseSources;
+    std::vector<int> coarseTargets;
+    coarseSources.reserve(keys.size());
+    coarseTargets.reserve(keys.size());
+    for (long long key : keys) {
+        if (key >= 0) {
+            coarseSources.push_back(static_cast<int>(key >> 32));
+            coarseTargets.push_back(static_cast<int>(key & 0xffffffffLL));
+        }
+    }
+    return CsrGraph(groups, std::move(coarseSources), std::move(coarseTargets));
+}
+
+// Rearrange the connected components in rows by decreasing height (shelf
+// packing), each keeping its own layout. Gravity barely holds small
+// components and isolated vertices, so force layouts leave them on a wide
+// ring around the main component, which would then fill little of the image.
+void packComponents(const CsrGraph& graph, std::vector<float>& x, std::vector<float>& y) {
+    int n = graph.getVertexCount();
+    std::vector<int> component(n, -1);
+    int count = 0;
+    std::vector<int> stack;
+    for (int start = 0; start < n; start++) {
+        if (component[start] >= 0) {
+            continue;
+        }
+        component[start] = count;
+        stack.assign(1, start);
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            for (const int* u = graph.neighborsBegin(v); u != graph.neighborsEnd(v); u++) {
+                if (component[*u] < 0) {
+                    component[*u] = count;
+                    stack.push_back(*u);
+                }
+            }
+        }
+        count++;
+    }
+    if (count <= 1) {
+        return;
+    }
+
+    std::vector<Bounds> boxes(count, Bounds{INFINITY, INFINITY, -INFINITY, -INFINITY});
+    for (int v = 0; v < n; v++) {
+        Bounds& box = boxes[component[v]];
+        box.minX = std::min(box.minX, x[v]);
+        box.minY = std::min(box.minY, y[v]);
+        box.maxX = std::max(box.maxX, x[v]);
+        box.maxY = std::max(box.maxY, y[v]);
+    }
+
+    // Components are spaced like adjacent vertices: by the mean edge length
+    const std::vector<int>& sources = graph.getEdgeSources();
+    const std::vector<int>& targets = graph.getEdgeTargets();
+    double totalLength = 0.0;
+    for (size_t e = 0; e < sources.size(); e++) {
+        totalLength += std::hypot(x[sources[e]] - x[targets[e]], y[sources[e]] - y[targets[e]]);
+    }
+    float gap = sources.empty() ? 1.0f : static_cast<float>(totalLength / sources.size());
+
+    // Rows about as wide as the packing is tall, or as the widest component
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return boxes[a].maxY - boxes[a].minY > boxes[b].maxY - boxes[b].minY;
+    });
+    double area = 0.0;
+    float rowWidth = 0.0f;
+    for (const Bounds& box : boxes) {
+        area += double(box.maxX - box.minX + gap) * (box.maxY - box.minY + gap);
+        rowWidth = std::max(rowWidth, box.maxX - box.minX);
+    }
+    rowWidth = std::max(rowWidth, static_cast<float>(std::sqrt(area)));
+
+    std::vector<float> shiftX(count);
+    std::vector<float> shiftY(count);
+    float cursorX = 0.0f;
+    float cursorY = 0.0f;
+    float rowHeight = 0.0f;
+    for (int c : order) {
+        float width = boxes[c].maxX - boxes[c].minX;
+        float height = boxes[c].maxY - boxes[c].minY;
+        if (cursorX > 0.0f && cursorX + width > rowWidth) {
+            cursorX = 0.0f;
+            cursorY += rowHeight + gap;
+            rowHeight = 0.0f;
+        }
+        shiftX[c] = cursorX - boxes[c].minX;
+        shiftY[c] = cursorY - boxes[c].minY;
+        cursorX += width + gap;
+        rowHeight = std::max(rowHeight, height);
+    }
+    for (int v = 0; v < n; v++) {
+        x[v] += shiftX[component[v]];
+        y[v] += shiftY[component[v]];
+    }
+}
+
+} // namespace
+
+MultilevelLayout::MultilevelLayout(const Graph& graph, const MultilevelLayoutOptions& options)
+    : options(options) {
+    levels.emplace_back(graph);
+    coarsen();
+}
+
+void MultilevelLayout::coarsen() {
+    GC_TRACE_SCOPE("coarsen graph");
+
+    std::mt19937 rng(options.seed);
+    while (levels.back().getVertexCount() > options.coarsestSize) {
+        const CsrGraph& fine = levels.back();
+        std::vector<int> parent;
+        int groups = matchVertices(fine, rng, parent);
+        if (groups > MIN_SHRINK * fine.getVertexCount()) {
+            break;
+        }
+        CsrGraph coarse = buildCoarseGraph(fine, parent, groups);
+        parents.push_back(std::move(parent));
+        levels.push_back(std::move(coarse));
+    }
+}
+
+void MultilevelLayout::run() {
+    GC_TRACE_SCOPE("multilevel layout");
+
+    std::mt19937 rng(options.seed);
+    double finestSize = std::max(levels[0].getVertexCount(), 1);
+    for (int level = getLevelCount() - 1; level >= 0; level--) {
+        int n = levels[level].getVertexCount();
+        ForceLayoutOptions force = options.force;
+        force.maxIterations = level == getLevelCount() - 1
+                                  ? options.coarsestIterations
+                                  : std::min(options.coarsestIterations,
+                                             static_cast<int>(options.refineIterations *
+                                                              std::sqrt(finestSize / std::max(n, 1))));
+        ForceLayout layout(levels[level], force);
+
+        if (level < getLevelCount() - 1) {
+            // Start each vertex at its group's position, spread out so the
+            // level's larger vertex count has room (layouts grow about with
+            // the square root of the vertex count); a little jitter separates
+            // the members of a group
+            const std::vector<int>& parent = parents[level];
+            float spread = std::sqrt(static_cast<float>(n) / levels[level + 1].getVertexCount());
+            std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+            std::vector<float> fineX(n);
+            std::vector<float> fineY(n);
+            for (int v = 0; v < n; v++) {
+                fineX[v] = x[parent[v]] * spread + jitter(rng);
+                fineY[v] = y[parent[v]] * spread + jitter(rng);
+            }
+            layout.setPositions(fineX, fineY);
+        }
+
+        layout.run();
+        x = layout.getX();
+        y = layout.getY();
+    }
+    packComponents(levels[0], x, y);
+}
+
+void MultilevelLayout::apply(Graph& graph) const {
+    applyLayout(graph, x, y);
+}
+
+} // namespace graph_coloring
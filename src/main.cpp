@@ -1,175 +1,46 @@
 ﻿#include <iostream>
 #include <chrono>
-#include <thread>
+#include <cstdlib>
 #include <random>
 #include <ctime>
 #include <memory>
 #include <string>
 #include "../include/graph/graph.hpp"
+#include "../include/coloring/solve_options.hpp"
+#include "../include/io/progress_printer.hpp"
+#include "../include/io/result_writer.hpp"
+#include "../include/generators/generators.hpp"
 #include "../include/canvas/canvas.hpp"
+#include "../include/layout/force_layout.hpp"
+#include "../include/trace/trace.hpp"
+#include "../include/parallel/thread_pool.hpp"
 
 using namespace graph_coloring;
 
 // Function to create a complete graph (K5)
 Graph createCompleteGraph() {
-    Graph graph;
-    
-    // Add vertices in a regular pentagon layout (more standard for K5)
-    const float centerX = 0.5f;
-    const float centerY = 0.5f;
-    const float radius = 0.35f;
-    
-    // Add vertices in a pentagon arrangement
-    for (int i = 0; i < 5; i++) {
-        float angle = 2.0f * 3.14159f * i / 5;  // evenly spaced around a circle
-        float x = centerX + radius * cos(angle);
-        float y = centerY + radius * sin(angle);
-        graph.addVertex(x, y);
-    }
-    
-    // Connect every vertex to every other vertex (complete graph definition)
-    for (int i = 0; i < 5; i++) {
-        for (int j = i + 1; j < 5; j++) {
-            graph.addEdge(i, j);
-        }
-    }
-    
     std::cout << "K5 requires exactly 5 colors because each vertex connects to all others." << std::endl;
-    
-    return graph;
+    return GraphGenerator::complete(5);
 }
 
 // Function to create a cycle graph
 Graph createCycleGraph() {
-    Graph graph;
-    
-    // Create vertices in a circular arrangement
-    const int numVertices = 8;
-    const float centerX = 0.5f;
-    const float centerY = 0.5f;
-    const float radius = 0.35f;
-    
-    // Add vertices in a circle
-    for (int i = 0; i < numVertices; i++) {
-        float angle = 2.0f * 3.14159f * i / numVertices;
-        float x = centerX + radius * cos(angle);
-        float y = centerY + radius * sin(angle);
-        graph.addVertex(x, y);
-    }
-    
-    // Connect vertices in a cycle
-    for (int i = 0; i < numVertices; i++) {
-        graph.addEdge(i, (i + 1) % numVertices);
-    }
-    
-    return graph;
+    return GraphGenerator::cycle(8);
 }
 
 // Function to create a grid graph
 Graph createGridGraph() {
-    Graph graph;
-    
-    // Create a 4x4 grid graph
-    const int gridSize = 4;
-    const float spacing = 1.0f / (gridSize + 1);
-    
-    // Add vertices in a grid pattern
-    for (int row = 0; row < gridSize; row++) {
-        for (int col = 0; col < gridSize; col++) {
-            float x = spacing * (col + 1);
-            float y = spacing * (row + 1);
-            graph.addVertex(x, y);
-        }
-    }
-    
-    // Connect vertices in the grid
-    for (int row = 0; row < gridSize; row++) {
-        for (int col = 0; col < gridSize; col++) {
-            int currentIndex = row * gridSize + col;
-            
-            // Connect to right neighbor
-            if (col < gridSize - 1) {
-                graph.addEdge(currentIndex, currentIndex + 1);
-            }
-            
-            // Connect to bottom neighbor
-            if (row < gridSize - 1) {
-                graph.addEdge(currentIndex, currentIndex + gridSize);
-            }
-        }
-    }
-    
-    return graph;
+    return GraphGenerator::grid(4, 4);
 }
 
 // Function to create a star graph
 Graph createStarGraph() {
-    Graph graph;
-    
-    // Create a central vertex
-    graph.addVertex(0.5f, 0.5f);  // id: 0 (center)
-    
-    // Create outer vertices
-    const int numRays = 10;
-    const float radius = 0.4f;
-    
-    for (int i = 0; i < numRays; i++) {
-        float angle = 2.0f * 3.14159f * i / numRays;
-        float x = 0.5f + radius * cos(angle);
-        float y = 0.5f + radius * sin(angle);
-        graph.addVertex(x, y);  // id: 1 to numRays
-    }
-    
-    // Connect center to all outer vertices
-    for (int i = 1; i <= numRays; i++) {
-        graph.addEdge(0, i);
-    }
-    
-    return graph;
+    return GraphGenerator::star(10);
 }
 
 // Function to create a petersen graph (a common test case for graph coloring)
 Graph createPetersenGraph() {
-    Graph graph;
-    
-    // Create outer pentagon vertices
-    const float outerRadius = 0.4f;
-    const float innerRadius = 0.2f;
-    const float centerX = 0.5f;
-    const float centerY = 0.5f;
-    
-    // Add outer pentagon vertices (0-4)
-    for (int i = 0; i < 5; i++) {
-        float angle = 2.0f * 3.14159f * i / 5;
-        float x = centerX + outerRadius * cos(angle);
-        float y = centerY + outerRadius * sin(angle);
-        graph.addVertex(x, y);
-    }
-    
-    // Add inner pentagon vertices (5-9)
-    for (int i = 0; i < 5; i++) {
-        float angle = 2.0f * 3.14159f * i / 5 + 3.14159f / 5;  // offset by half a segment
-        float x = centerX + innerRadius * cos(angle);
-        float y = centerY + innerRadius * sin(angle);
-        graph.addVertex(x, y);
-    }
-    
-    // Connect outer pentagon
-    for (int i = 0; i < 5; i++) {
-        graph.addEdge(i, (i + 1) % 5);
-    }
-    
-    // Connect each outer vertex to its corresponding inner vertex
-    for (int i = 0; i < 5; i++) {
-        graph.addEdge(i, i + 5);
-    }
-    
-    // Connect inner vertices (create a star)
-    for (int i = 0; i < 5; i++) {
-        graph.addEdge(5 + i, 5 + ((i + 2) % 5));
-    }
-    
-    return graph;
+    return GraphGenerator::petersen();
 }
 
 // Function to randomly select a graph from the available options
@@ -207,15 +78,29 @@ Graph getRandomGraph() {
 void printUsage() {
     std::cout << "Usage: GraphColoring [options]" << std::endl;
     std::cout << "Options:" << std::endl;
-    std::cout << "  --algorithm=<alg>    Coloring algorithm: 'greedy', 'sf', or 'exact' (default: greedy)" << std::endl;
+    std::cout << "  --algorithm=<alg>    Coloring algorithm: 'greedy', 'sf', 'sl', 'dsatur', 'rlf', 'exact'" << std::endl;
+    std::cout << "                       or 'portfolio' to race them all (default: greedy)" << std::endl;
+    std::cout << "  --time-limit=<sec>   Stop the solve after this long and keep its best coloring" << std::endl;
+    std::cout << "  --node-limit=<n>     Stop exact search after this many assignments" << std::endl;
+    std::cout << "  --threads=<n>        Worker threads in the shared thread pool (default: all cores)" << std::endl;
+    std::cout << "  --pin-threads        Pin each pool thread to one CPU" << std::endl;
+    std::cout << "  --layout=<alg>       Vertex positions: 'force' (animated), 'multilevel' or 'circular'" << std::endl;
+    std::cout << "  --trace=<file>       Write a Chrome trace of solver and render zones on exit" << std::endl;
+    std::cout << "  --progress           Print each improvement (colors, lower bound, time, nodes) to stderr" << std::endl;
     std::cout << "  --help               Show this help message" << std::endl;
+    std::cout << "Graph files are colored in batch by graphcoloring_cli, which needs no display." << std::endl;
 }
 
 int main(int argc, char** argv) {
-    std::cout << "Graph Coloring Demonstration" << std::endl;
-    
     // Parse command line arguments
     ColoringAlgorithm algorithm = ColoringAlgorithm::Greedy;
+    SolveOptions solveOptions;
+    LayoutAlgorithm layout = LayoutAlgorithm::Circular;
+    std::string tracePath;
+    int poolThreads = 0;
+    bool pinThreads = false;
+    bool showProgress = false;
+    bool layoutRequested = false; // The sample graph keeps its own positions otherwise
     
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -225,17 +110,35 @@ int main(int argc, char** argv) {
             return 0;
         } else if (arg.find("--algorithm=") == 0) {
             std::string value = arg.substr(12);
-            if (value == "sf") {
-                algorithm = ColoringAlgorithm::SF;
-            } else if (value == "greedy") {
-                algorithm = ColoringAlgorithm::Greedy;
-            } else if (value == "exact") {
-                algorithm = ColoringAlgorithm::Exact;
-            } else {
+            if (!parseColoringAlgorithm(value, algorithm)) {
                 std::cerr << "Invalid algorithm: " << value << std::endl;
                 printUsage();
                 return 1;
             }
+        } else if (arg.find("--time-limit=") == 0) {
+            solveOptions.timeLimitSeconds = std::atof(arg.substr(13).c_str());
+        } else if (arg.find("--node-limit=") == 0) {
+            solveOptions.nodeLimit = std::atoll(arg.substr(13).c_str());
+        } else if (arg.find("--threads=") == 0) {
+            poolThreads = std::atoi(arg.substr(10).c_str());
+        } else if (arg == "--pin-threads") {
+            pinThreads = true;
+        } else if (arg.find("--layout=") == 0) {
+            std::string value = arg.substr(9);
+            if (!parseLayoutAlgorithm(value, layout)) {
+                std::cerr << "Invalid layout: " << value << std::endl;
+                printUsage();
+                return 1;
+            }
+            layoutRequested = true;
+        } else if (arg.find("--trace=") == 0) {
+            tracePath = arg.substr(8);
+        } else if (arg == "--progress") {
+            showProgress = true;
+        } else if (arg == "--headless" || arg.find("--") != 0) {
+            std::cerr << "Batch coloring of graph files moved to graphcoloring_cli" << std::endl;
+            printUsage();
+            return 1;
         } else {
             std::cerr << "Unknown option: " << arg << std::endl;
             printUsage();
@@ -243,13 +146,28 @@ int main(int argc, char** argv) {
         }
     }
     
+    ThreadPool::configureGlobal(poolThreads, pinThreads);
+    startTracing(tracePath);
+    
+    std::unique_ptr<ProgressPrinter> progressPrinter;
+    if (showProgress) {
+        progressPrinter = std::make_unique<ProgressPrinter>();
+        ProgressPrinter* printer = progressPrinter.get();
+        solveOptions.progress = [printer](const SolveProgress& progress) {
+            printer->push("sample graph", progress);
+        };
+    }
+    
+    std::cout << "Graph Coloring Demonstration" << std::endl;
+    
     // Create a random sample graph
     Graph graph = getRandomGraph();
     
     // Apply graph coloring algorithm
     auto startTime = std::chrono::high_resolution_clock::now();
-    graph.colorGraph(algorithm);
+    graph.colorGraph(algorithm, solveOptions);
     auto endTime = std::chrono::high_resolution_clock::now();
+    progressPrinter.reset();
     
     // Calculate and print execution time
     std::chrono::duration<double, std::milli> duration = endTime - startTime;
@@ -257,12 +175,9 @@ int main(int argc, char** argv) {
     
     // Print results
     std::cout << "Number of colors used: " << graph.getNumberOfColors() << std::endl;
-    std::cout << "Vertex colors:" << std::endl;
-    
-    for (const auto& vertex : graph.getVertices()) {
-        int id = vertex.getId();
-        std::cout << "Vertex " << id << ": Color " << graph.getVertexColor(id) << std::endl;
-    }
+    std::cout << "Solver stats: " << graph.getLastStats().toJson() << std::endl;
+    std::cout << "Vertex colors (vertex color):" << std::endl;
+    ResultWriter::write(std::cout, ColoringRecord::fromGraph(graph), ResultFormat::Text);
     
     std::cout << "Is coloring valid? " << (graph.isValidColoring() ? "Yes" : "No") << std::endl;
     
@@ -278,14 +193,38 @@ int main(int argc, char** argv) {
     // Set the graph for rendering
     canvas.setGraph(&graph);
     
-    // Main loop
+    // A force layout starts from random positions and is shown converging:
+    // each frame runs steps for up to a frame's time, then applies them
+    std::unique_ptr<ForceLayout> forceLayout;
+    if (layoutRequested && layout == LayoutAlgorithm::Force) {
+        forceLayout = std::make_unique<ForceLayout>(graph);
+        forceLayout->apply(graph);
+        canvas.setAnimating(true);
+    } else if (layoutRequested) {
+        layoutGraph(graph, layout);
+    }
+    
+    // Main loop: sleeps until input, a window change or a graph change; while
+    // animating, frames are paced by vsync
     while (!canvas.shouldClose()) {
-        canvas.processInput();
+        if (forceLayout) {
+            auto frameStart = std::chrono::steady_clock::now();
+            bool running = true;
+            while (running && std::chrono::steady_clock::now() - frameStart < std::chrono::milliseconds(15)) {
+                running = forceLayout->step();
+            }
+            forceLayout->apply(graph);
+            if (!running) {
+                std::cout << "Layout finished after " << forceLayout->getIteration() << " steps" << std::endl;
+                forceLayout.reset();
+                canvas.setAnimating(false);
+            }
+        }
         canvas.render();
-        
-        // Simple frame rate limiting
-        std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
+        canvas.waitEvents();
+        canvas.processInput();
     }
     
+    finishTracing(tracePath);
     return 0;
 }
@@ -0,0 +1,312 @@
+#include "../../include/parallel/thread_pool.hpp"
+#include "../../include/trace/trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace graph_coloring {
+
+namespace {
+
+// Pool and worker index of the calling thread
+thread_local ThreadPool* currentPool = nullptr;
+thread_local int currentIndex = -1;
+
+// Global pool settings and instance
+std::mutex globalMutex;
+std::unique_ptr<ThreadPool> globalInstance;
+int globalThreadCount = 0;
+bool globalPinThreads = false;
+
+} // namespace
+
+ThreadPool::ThreadPool(int threads, bool pinThreads)
+    : queued(0), sleepers(0), stopping(false), pinThreads(pinThreads) {
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    // Create every deque before any worker can try to steal from it
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(new Worker());
+    }
+    for (int i = 0; i < threads; i++) {
+        workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> function) {
+    submit(std::move(function), nullptr);
+}
+
+void ThreadPool::submit(std::function<void()> function, TaskGroup* group) {
+    Task* task = new Task{std::move(function), group};
+    
+    if (currentPool == this) {
+        workers[currentIndex]->deque.push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        injection.push_back(task);
+    }
+    
+    // Pairs with the sleepers/queued check in workerLoop so a wakeup is never lost
+    queued.fetch_add(1);
+    if (sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_one();
+    }
+}
+
+ThreadPool::Task* ThreadPool::findTask(int self, TaskGroup* group) {
+    Task* task = nullptr;
+    
+    // Own deque first (newest task, still warm in cache). A group's task may
+    // be buried under other groups' tasks (e.g. one submitted after it), so
+    // those are set aside until it is found and then pushed back in order.
+    if (self >= 0) {
+        WorkStealingDeque<Task*>& own = workers[self]->deque;
+        std::vector<Task*> foreign;
+        Task* found = nullptr;
+        while (own.pop(task)) {
+            if (!group || task->group == group) {
+                found = task;
+                break;
+            }
+            foreign.push_back(task);
+        }
+        for (auto other = foreign.rbegin(); other != foreign.rend(); ++other) {
+            own.push(*other);
+        }
+        if (found) {
+            queued.fetch_sub(1);
+            return found;
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        auto found = injection.begin();
+        if (group) {
+            found = std::find_if(injection.begin(), injection.end(),
+                                 [group](const Task* queuedTask) { return queuedTask->group == group; });
+        }
+        if (found != injection.end()) {
+            task = *found;
+            injection.erase(found);
+            queued.fetch_sub(1);
+            return task;
+        }
+    }
+    
+    // Steal the oldest task of another worker, starting after our own index.
+    // A stolen task of another group cannot be returned to its victim's
+    // deque, so it moves to the front of the injection queue unrun.
+    int count = static_cast<int>(workers.size());
+    int start = self >= 0 ? self + 1 : 0;
+    for (int i = 0; i < count; i++) {
+        int victim = (start + i) % count;
+        if (victim != self && workers[victim]->deque.steal(task)) {
+            if (!group || task->group == group) {
+                queued.fetch_sub(1);
+                return task;
+            }
+            std::lock_guard<std::mutex> lock(injectionMutex);
+            injection.push_front(task);
+        }
+    }
+    
+    return nullptr;
+}
+
+void ThreadPool::execute(Task* task) {
+    std::exception_ptr error;
+    if (!task->group || !task->group->isCancelled()) {
+        try {
+            GC_TRACE_SCOPE("pool task");
+            task->function();
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+    
+    TaskGroup* group = task->group;
+    delete task;
+    if (group) {
+        group->taskFinished(error);
+    }
+}
+
+bool ThreadPool::runPendingTask(TaskGroup* group) {
+    Task* task = findTask(currentPool == this ? currentIndex : -1, group);
+    if (!task) {
+        return false;
+    }
+    execute(task);
+    return true;
+}
+
+void ThreadPool::workerLoop(int index) {
+    currentPool = this;
+    currentIndex = index;
+    if (Tracer::isCompiledIn()) {
+        Tracer::setThreadName("pool worker " + std::to_string(index));
+    }
+    if (pinThreads) {
+        pinCurrentThread(index);
+    }
+    
+    while (true) {
+        Task* task = findTask(index, nullptr);
+        if (task) {
+            execute(task);
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        if (stopping.load() && queued.load() == 0) {
+            return;
+        }
+        sleepers.fetch_add(1);
+        wake.wait(lock, [this]() { return queued.load() > 0 || stopping.load(); });
+        sleepers.fetch_sub(1);
+    }
+}
+
+void ThreadPool::pinCurrentThread(int index) {
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cores, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << (index % std::min(cores, 64u)));
+#else
+    (void)index;
+    (void)cores;
+#endif
+}
+
+int ThreadPool::currentWorkerIndex() {
+    return currentIndex;
+}
+
+ThreadPool& ThreadPool::global() {
+    std::lock_guard<std::mutex> lock(globalMutex);
+    if (!globalInstance) {
+        globalInstance.reset(new ThreadPool(globalThreadCount, globalPinThreads));
+    }
+    return *globalInstance;
+}
+
+void ThreadPool::configureGlobal(int threads, bool pinThreads) {
+    std::lock_guard<std::mutex> lock(globalMutex);
+    if (globalInstance) {
+        throw std::runtime_error("Cannot configure the global thread pool after it has started");
+    }
+    globalThreadCount = threads;
+    globalPinThreads = pinThreads;
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool) : pool(pool), pending(0), cancelled(false) {
+}
+
+TaskGroup::~TaskGroup() {
+    // Tasks reference the group, so it cannot go away before they finish
+    try {
+        wait();
+    } catch (...) {
+    }
+}
+
+void TaskGroup::run(std::function<void()> function) {
+    pending.fetch_add(1);
+    pool.submit(std::move(function), this);
+}
+
+void TaskGroup::taskFinished(std::exception_ptr taskError) {
+    // Under the lock so wait() cannot return while this is still touching the group
+    std::lock_guard<std::mutex> lock(mutex);
+    if (taskError && !error) {
+        error = taskError;
+    }
+    if (pending.fetch_sub(1) == 1) {
+        done.notify_all();
+    }
+}
+
+void TaskGroup::wait() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (pending.load() == 0) {
+                if (error) {
+                    std::exception_ptr rethrow = error;
+                    error = nullptr;
+                    std::rethrow_exception(rethrow);
+                }
+                return;
+            }
+        }
+        
+        // Help with this group's pending tasks only: running anything else
+        // here (e.g. a whole batch file inside a solve's parallelFor) would
+        // hold up this wait and the caller for as long as that task takes.
+        // If there is none, our tasks are running elsewhere.
+        if (!pool.runPendingTask(this)) {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait_for(lock, std::chrono::milliseconds(1), [this]() { return pending.load() == 0; });
+        }
+    }
+}
+
+void TaskGroup::cancel() {
+    cancelled.store(true);
+}
+
+void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body,
+                 ThreadPool& pool) {
+    grain = std::max<size_t>(grain, 1);
+    if (end <= begin) {
+        return;
+    }
+    if (end - begin <= grain) {
+        body(begin, end);
+        return;
+    }
+    
+    // Hand off the upper half and keep splitting the lower one; idle workers
+    // steal the oldest (largest) halves first
+    TaskGroup group(pool);
+    std::function<void(size_t, size_t)> split = [&](size_t low, size_t high) {
+        while (high - low > grain) {
+            size_t mid = low + (high - low) / 2;
+            group.run([&split, mid, high]() { split(mid, high); });
+            high = mid;
+        }
+        body(low, high);
+    };
+    split(begin, end);
+    group.wait();
+}
+
+} // namespace graph_coloring
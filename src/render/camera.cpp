@@ -0,0 +1,44 @@
+#include "../../include/render/camera.hpp"
+#include <algorithm>
+
+namespace graph_coloring {
+
+Camera::Camera(int width, int height, float margin)
+    : width(width), height(height), margin(margin), centerX(0.5f), centerY(0.5f), zoom(1.0f), version(1) {
+}
+
+void Camera::setViewport(int width, int height) {
+    this->width = width;
+    this->height = height;
+    version++;
+}
+
+void Camera::reset() {
+    centerX = 0.5f;
+    centerY = 0.5f;
+    zoom = 1.0f;
+    version++;
+}
+
+void Camera::pan(float dx, float dy) {
+    centerX -= dx / getScaleX();
+    centerY -= dy / getScaleY();
+    version++;
+}
+
+void Camera::zoomAt(float x, float y, float factor) {
+    float layoutX = toLayoutX(x);
+    float layoutY = toLayoutY(y);
+    zoom = std::clamp(zoom * factor, MIN_ZOOM, MAX_ZOOM);
+
+    // Solve toScreen(layout) == (x, y) for the new center
+    centerX = layoutX - (x - width * 0.5f) / getScaleX();
+    centerY = layoutY - (y - height * 0.5f) / getScaleY();
+    version++;
+}
+
+Bounds Camera::visibleArea(float pixels) const {
+    return Bounds{toLayoutX(-pixels), toLayoutY(-pixels), toLayoutX(width + pixels), toLayoutY(height + pixels)};
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,180 @@
+#include "../../include/render/level_of_detail.hpp"
+#include "../../include/parallel/thread_pool.hpp"
+#include "../../include/trace/trace.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace graph_coloring {
+
+namespace {
+
+// Edges per parallelFor chunk
+const size_t EDGE_GRAIN = 4096;
+
+void resizeImage(const Camera& camera, int cellSize, DensityImage& image) {
+    image.cellSize = cellSize;
+    image.columns = std::max((camera.getWidth() + cellSize - 1) / cellSize, 1);
+    image.rows = std::max((camera.getHeight() + cellSize - 1) / cellSize, 1);
+    image.rgba.assign(static_cast<size_t>(image.columns) * image.rows * 4, 0);
+}
+
+// Clip the segment to [0, width] x [0, height] (Liang-Barsky); false if it misses
+bool clipSegment(float& x0, float& y0, float& x1, float& y1, float width, float height) {
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    const float p[4] = {-dx, dx, -dy, dy};
+    const float q[4] = {x0, width - x0, y0, height - y0};
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0.0f) {
+            if (q[i] < 0.0f) {
+                return false;
+            }
+        } else {
+            float t = q[i] / p[i];
+            if (p[i] < 0.0f) {
+                t0 = std::max(t0, t);
+            } else {
+                t1 = std::min(t1, t);
+            }
+        }
+    }
+    if (t0 > t1) {
+        return false;
+    }
+
+    float startX = x0 + t0 * dx;
+    float startY = y0 + t0 * dy;
+    x1 = x0 + t1 * dx;
+    y1 = y0 + t1 * dy;
+    x0 = startX;
+    y0 = startY;
+    return true;
+}
+
+} // namespace
+
+void buildVertexCells(const Graph& graph, const std::vector<int>& colors, const Palette& palette,
+                      const Camera& camera, const std::vector<int>* subset, int cellSize, DensityImage& image) {
+    GC_TRACE_SCOPE("vertex cells");
+
+    resizeImage(camera, cellSize, image);
+    size_t cellCount = static_cast<size_t>(image.columns) * image.rows;
+    std::vector<float> sums(cellCount * 3, 0.0f);
+    std::vector<int> counts(cellCount, 0);
+
+    const std::vector<Vertex>& vertices = graph.getVertices();
+    auto add = [&](int v) {
+        float x = camera.toScreenX(vertices[v].getX());
+        float y = camera.toScreenY(vertices[v].getY());
+        if (x < 0.0f || y < 0.0f || x >= camera.getWidth() || y >= camera.getHeight()) {
+            return;
+        }
+        size_t cell = static_cast<size_t>(y / cellSize) * image.columns + static_cast<size_t>(x / cellSize);
+        const float* color = palette.getColor(colors[v]);
+        sums[3 * cell] += color[0];
+        sums[3 * cell + 1] += color[1];
+        sums[3 * cell + 2] += color[2];
+        counts[cell]++;
+    };
+    if (subset) {
+        for (int v : *subset) {
+            add(v);
+        }
+    } else {
+        for (size_t v = 0; v < vertices.size(); v++) {
+            add(static_cast<int>(v));
+        }
+    }
+
+    // Opacity grows with the log of the count so sparse cells stay visible
+    int maxCount = *std::max_element(counts.begin(), counts.end());
+    float scale = maxCount > 1 ? 1.0f / std::log(1.0f + maxCount) : 0.0f;
+    for (size_t cell = 0; cell < cellCount; cell++) {
+        if (counts[cell] == 0) {
+            continue;
+        }
+        unsigned char* texel = &image.rgba[4 * cell];
+        for (int c = 0; c < 3; c++) {
+            texel[c] = static_cast<unsigned char>(sums[3 * cell + c] / counts[cell] * 255.0f + 0.5f);
+        }
+        float opacity = 0.4f + 0.6f * std::log(1.0f + counts[cell]) * scale;
+        texel[3] = static_cast<unsigned char>(std::min(opacity, 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+void buildEdgeDensity(const Graph& graph, const std::vector<int>& edgeEndpoints, const Camera& camera,
+                      const std::vector<int>* subset, int cellSize, DensityImage& image) {
+    GC_TRACE_SCOPE("edge density");
+
+    resizeImage(camera, cellSize, image);
+    size_t cellCount = static_cast<size_t>(image.columns) * image.rows;
+    size_t edgeCount = subset ? subset->size() : edgeEndpoints.size() / 2;
+    size_t chunks = std::max<size_t>(std::min<size_t>(ThreadPool::global().getThreadCount(),
+                                                      edgeCount / EDGE_GRAIN), 1);
+    size_t chunkSize = (edgeCount + chunks - 1) / chunks;
+    std::vector<std::vector<float>> partial(chunks);
+
+    const std::vector<Vertex>& vertices = graph.getVertices();
+    float width = static_cast<float>(camera.getWidth());
+    float height = static_cast<float>(camera.getHeight());
+    float cellScale = 1.0f / cellSize;
+    int lastColumn = image.columns - 1;
+    int lastRow = image.rows - 1;
+
+    // Each chunk of edges accumulates into its own grid
+    parallelFor(0, chunks, 1, [&](size_t first, size_t last) {
+        for (size_t chunk = first; chunk < last; chunk++) {
+            std::vector<float>& density = partial[chunk];
+            density.assign(cellCount, 0.0f);
+            size_t end = std::min(edgeCount, (chunk + 1) * chunkSize);
+            for (size_t i = chunk * chunkSize; i < end; i++) {
+                size_t edge = subset ? (*subset)[i] : i;
+                const Vertex& source = vertices[edgeEndpoints[2 * edge]];
+                const Vertex& target = vertices[edgeEndpoints[2 * edge + 1]];
+                float x0 = camera.toScreenX(source.getX());
+                float y0 = camera.toScreenY(source.getY());
+                float x1 = camera.toScreenX(target.getX());
+                float y1 = camera.toScreenY(target.getY());
+                if (!clipSegment(x0, y0, x1, y1, width, height)) {
+                    continue;
+                }
+
+                // Walk in cell units, one sample per cell along the major axis
+                x0 *= cellScale;
+                y0 *= cellScale;
+                x1 *= cellScale;
+                y1 *= cellScale;
+                int steps = static_cast<int>(std::max(std::abs(x1 - x0), std::abs(y1 - y0))) + 1;
+                float stepX = (x1 - x0) / steps;
+                float stepY = (y1 - y0) / steps;
+                float x = x0 + 0.5f * stepX;
+                float y = y0 + 0.5f * stepY;
+                for (int s = 0; s < steps; s++, x += stepX, y += stepY) {
+                    int column = std::min(static_cast<int>(x), lastColumn);
+                    int row = std::min(static_cast<int>(y), lastRow);
+                    density[static_cast<size_t>(row) * image.columns + column] += 1.0f;
+                }
+            }
+        }
+    });
+
+    std::vector<float>& total = partial[0];
+    for (size_t chunk = 1; chunk < chunks; chunk++) {
+        for (size_t cell = 0; cell < cellCount; cell++) {
+            total[cell] += partial[chunk][cell];
+        }
+    }
+
+    float maxDensity = *std::max_element(total.begin(), total.end());
+    float scale = maxDensity > 0.0f ? 1.0f / std::log(1.0f + maxDensity) : 0.0f;
+    for (size_t cell = 0; cell < cellCount; cell++) {
+        if (total[cell] > 0.0f) {
+            float opacity = 0.15f + 0.75f * std::log(1.0f + total[cell]) * scale;
+            image.rgba[4 * cell + 3] = static_cast<unsigned char>(std::min(opacity, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,77 @@
+#include "../../include/render/palette.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace graph_coloring {
+
+namespace {
+
+// Hue of class 0 (red) and the step between classes: 360 / golden ratio^2,
+// which keeps the hues spread evenly however many classes there are
+const float FIRST_HUE = 0.5f;
+const float GOLDEN_ANGLE = 2.39996323f;
+const float LIGHTNESS[3] = {0.68f, 0.52f, 0.84f};
+const float MAX_CHROMA = 0.2f;
+const float UNCOLORED[3] = {0.5f, 0.5f, 0.5f};
+
+// OKLab to linear sRGB
+void oklabToLinear(float lightness, float a, float b, float rgb[3]) {
+    float l = lightness + 0.3963377774f * a + 0.2158037573f * b;
+    float m = lightness - 0.1055613458f * a - 0.0638541728f * b;
+    float s = lightness - 0.0894841775f * a - 1.2914855480f * b;
+    l = l * l * l;
+    m = m * m * m;
+    s = s * s * s;
+    rgb[0] = 4.0767416621f * l - 3.3077115913f * m + 0.2309699292f * s;
+    rgb[1] = -1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * s;
+    rgb[2] = -0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * s;
+}
+
+bool inGamut(const float rgb[3]) {
+    for (int c = 0; c < 3; c++) {
+        if (rgb[c] < 0.0f || rgb[c] > 1.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float toSrgb(float linear) {
+    linear = std::clamp(linear, 0.0f, 1.0f);
+    return linear <= 0.0031308f ? 12.92f * linear : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+}
+
+} // namespace
+
+void paletteColor(int color, float rgb[3]) {
+    float hue = FIRST_HUE + GOLDEN_ANGLE * color;
+    float lightness = LIGHTNESS[color % 3];
+    float cosHue = std::cos(hue);
+    float sinHue = std::sin(hue);
+
+    // Most saturated chroma that stays inside sRGB at this hue and lightness
+    float low = 0.0f;
+    float high = MAX_CHROMA;
+    for (int i = 0; i < 12; i++) {
+        float chroma = (low + high) * 0.5f;
+        oklabToLinear(lightness, chroma * cosHue, chroma * sinHue, rgb);
+        if (inGamut(rgb)) {
+            low = chroma;
+        } else {
+            high = chroma;
+        }
+    }
+    oklabToLinear(lightness, low * cosHue, low * sinHue, rgb);
+    for (int c = 0; c < 3; c++) {
+        rgb[c] = toSrgb(rgb[c]);
+    }
+}
+
+Palette::Palette(int colorCount) : colorCount(std::max(colorCount, 0)), rgb(3 * (this->colorCount + 1)) {
+    for (int color = 0; color < this->colorCount; color++) {
+        paletteColor(color, &rgb[3 * color]);
+    }
+    std::copy(UNCOLORED, UNCOLORED + 3, &rgb[3 * this->colorCount]);
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,331 @@
+#include "../../include/render/rasterizer.hpp"
+#include "../../include/render/palette.hpp"
+#include "../../include/render/tiled_image.hpp"
+#include "../../include/trace/trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+namespace graph_coloring {
+
+namespace {
+
+const float BLACK[3] = {0.0f, 0.0f, 0.0f};
+
+// Coverage of a pixel whose center is distance away from the edge of a shape
+// that extends halfWidth around its center line (or radius around its center)
+float coverageAt(float distance, float halfWidth) {
+    return std::clamp(halfWidth + 0.5f - distance, 0.0f, 1.0f);
+}
+
+// RGB bytes of a width x height image, checked before anything is allocated
+// (e.g. two negative sizes would otherwise multiply to a huge buffer)
+size_t pixelBytes(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        throw std::runtime_error("Image size must be positive");
+    }
+    return static_cast<size_t>(width) * height * 3;
+}
+
+} // namespace
+
+RasterImage::RasterImage(int originX, int originY, int width, int height)
+    : originX(originX), originY(originY), width(width), height(height),
+      pixels(pixelBytes(width, height)) {
+}
+
+void RasterImage::fill(const unsigned char rgb[3]) {
+    for (size_t i = 0; i < pixels.size(); i += 3) {
+        pixels[i] = rgb[0];
+        pixels[i + 1] = rgb[1];
+        pixels[i + 2] = rgb[2];
+    }
+}
+
+void RasterImage::blend(int x, int y, const float rgb[3], float coverage) {
+    x -= originX;
+    y -= originY;
+    if (x < 0 || y < 0 || x >= width || y >= height || coverage <= 0.0f) {
+        return;
+    }
+
+    unsigned char* pixel = &pixels[(static_cast<size_t>(y) * width + x) * 3];
+    for (int c = 0; c < 3; c++) {
+        float mixed = pixel[c] + (rgb[c] * 255.0f - pixel[c]) * coverage;
+        pixel[c] = static_cast<unsigned char>(mixed + 0.5f);
+    }
+}
+
+GraphRaster::GraphRaster(const Graph& graph, const ImageStyle& style) : style(style) {
+    GC_TRACE_SCOPE("project image");
+
+    // Same mapping as the viewer: whole circles stay inside the image
+    const std::vector<Vertex>& vertices = graph.getVertices();
+    float radius = style.vertexRadius;
+    positions.resize(vertices.size() * 2);
+    colors.resize(vertices.size());
+    int colorCount = 0;
+    for (size_t i = 0; i < vertices.size(); i++) {
+        positions[2 * i] = vertices[i].getX() * (style.width - 2 * radius) + radius;
+        positions[2 * i + 1] = vertices[i].getY() * (style.height - 2 * radius) + radius;
+        colors[i] = graph.getVertexColor(vertices[i].getId());
+        colorCount = std::max(colorCount, colors[i] + 1);
+    }
+    palette = Palette(colorCount);
+    for (int& color : colors) {
+        color = palette.indexOf(color);
+    }
+
+    if (style.edgeWidth > 0.0f) {
+        edges = graph.getEdgeEndpoints();
+    }
+}
+
+void GraphRaster::drawEdge(RasterImage& region, int edge) const {
+    float x0 = positions[2 * edges[2 * edge]];
+    float y0 = positions[2 * edges[2 * edge] + 1];
+    float x1 = positions[2 * edges[2 * edge + 1]];
+    float y1 = positions[2 * edges[2 * edge + 1] + 1];
+    float halfWidth = style.edgeWidth * 0.5f;
+    float reach = halfWidth + 1.0f;
+
+    // Skip edges whose bounding box misses the region
+    int left = region.getOriginX();
+    int top = region.getOriginY();
+    int right = left + region.getWidth();
+    int bottom = top + region.getHeight();
+    if (std::max(x0, x1) + reach < left || std::min(x0, x1) - reach > right ||
+        std::max(y0, y1) + reach < top || std::min(y0, y1) - reach > bottom) {
+        return;
+    }
+
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float lengthSquared = dx * dx + dy * dy;
+
+    // Walk the major axis; at each step only a few pixels across the line can be covered
+    bool steep = std::abs(dy) > std::abs(dx);
+    float majorStart = steep ? std::min(y0, y1) : std::min(x0, x1);
+    float majorEnd = steep ? std::max(y0, y1) : std::max(x0, x1);
+    int majorFirst = std::max(static_cast<int>(std::floor(majorStart - reach)), steep ? top : left);
+    int majorLast = std::min(static_cast<int>(std::ceil(majorEnd + reach)), (steep ? bottom : right) - 1);
+    float majorDelta = steep ? dy : dx;
+    float minorDelta = steep ? dx : dy;
+    float majorOrigin = steep ? y0 : x0;
+    float minorOrigin = steep ? x0 : y0;
+    float slope = majorDelta != 0.0f ? minorDelta / majorDelta : 0.0f;
+    float spread = reach * std::sqrt(1.0f + slope * slope);
+
+    for (int major = majorFirst; major <= majorLast; major++) {
+        float center = minorOrigin + (major + 0.5f - majorOrigin) * slope;
+        int minorFirst = static_cast<int>(std::floor(center - spread));
+        int minorLast = static_cast<int>(std::ceil(center + spread));
+        if (steep) {
+            minorFirst = std::max(minorFirst, left);
+            minorLast = std::min(minorLast, right - 1);
+        } else {
+            minorFirst = std::max(minorFirst, top);
+            minorLast = std::min(minorLast, bottom - 1);
+        }
+
+        for (int minor = minorFirst; minor <= minorLast; minor++) {
+            int x = steep ? minor : major;
+            int y = steep ? major : minor;
+
+            // Distance from the pixel center to the segment
+            float px = x + 0.5f - x0;
+            float py = y + 0.5f - y0;
+            float t = lengthSquared > 0.0f ? std::clamp((px * dx + py * dy) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+            float distance = std::hypot(px - t * dx, py - t * dy);
+            region.blend(x, y, BLACK, coverageAt(distance, halfWidth) * style.edgeOpacity);
+        }
+    }
+}
+
+void GraphRaster::drawVertex(RasterImage& region, int vertex) const {
+    float cx = positions[2 * vertex];
+    float cy = positions[2 * vertex + 1];
+    float radius = style.vertexRadius;
+    float innerRadius = std::max(radius - style.outlineWidth, 0.0f);
+    const float* fill = palette.getColor(colors[vertex]);
+
+    int left = std::max(static_cast<int>(std::floor(cx - radius - 1.0f)), region.getOriginX());
+    int right = std::min(static_cast<int>(std::ceil(cx + radius + 1.0f)), region.getOriginX() + region.getWidth() - 1);
+    int top = std::max(static_cast<int>(std::floor(cy - radius - 1.0f)), region.getOriginY());
+    int bottom = std::min(static_cast<int>(std::ceil(cy + radius + 1.0f)), region.getOriginY() + region.getHeight() - 1);
+
+    for (int y = top; y <= bottom; y++) {
+        for (int x = left; x <= right; x++) {
+            float distance = std::hypot(x + 0.5f - cx, y + 0.5f - cy);
+            if (style.outlineWidth > 0.0f) {
+                region.blend(x, y, BLACK, coverageAt(distance, radius));
+            }
+            region.blend(x, y, fill, coverageAt(distance, innerRadius));
+        }
+    }
+}
+
+void GraphRaster::renderRegion(RasterImage& region) const {
+    region.fill(style.background);
+
+    for (int e = 0; e < getEdgeCount(); e++) {
+        drawEdge(region, e);
+    }
+    for (int v = 0; v < getVertexCount(); v++) {
+        drawVertex(region, v);
+    }
+}
+
+void GraphRaster::renderRegion(RasterImage& region, const std::vector<int>& edgeList,
+                               const std::vector<int>& vertexList) const {
+    region.fill(style.background);
+
+    for (int e : edgeList) {
+        drawEdge(region, e);
+    }
+    for (int v : vertexList) {
+        drawVertex(region, v);
+    }
+}
+
+GraphRaster::BandSweep GraphRaster::startSweep() const {
+    BandSweep sweep;
+    sweep.edgeOrder.resize(getEdgeCount());
+    std::iota(sweep.edgeOrder.begin(), sweep.edgeOrder.end(), 0);
+    std::sort(sweep.edgeOrder.begin(), sweep.edgeOrder.end(), [this](int a, int b) { return edgeTop(a) < edgeTop(b); });
+
+    sweep.vertexOrder.resize(getVertexCount());
+    std::iota(sweep.vertexOrder.begin(), sweep.vertexOrder.end(), 0);
+    std::sort(sweep.vertexOrder.begin(), sweep.vertexOrder.end(),
+              [this](int a, int b) { return positions[2 * a + 1] < positions[2 * b + 1]; });
+    return sweep;
+}
+
+void GraphRaster::binBand(int top, int bottom, int tileSize, BandSweep& sweep,
+                          std::vector<std::vector<int>>& edgeBins, std::vector<std::vector<int>>& vertexBins) const {
+    int columns = (style.width + tileSize - 1) / tileSize;
+    edgeBins.resize(columns);
+    vertexBins.resize(columns);
+    for (int c = 0; c < columns; c++) {
+        edgeBins[c].clear();
+        vertexBins[c].clear();
+    }
+
+    // Add item to every column overlapping [minX, maxX]
+    auto addColumns = [&](std::vector<std::vector<int>>& bins, float minX, float maxX, int item) {
+        int first = std::max(static_cast<int>(std::floor(minX)) / tileSize, 0);
+        int last = std::min(static_cast<int>(std::floor(maxX)) / tileSize, columns - 1);
+        for (int c = first; c <= last; c++) {
+            bins[c].push_back(item);
+        }
+    };
+
+    // Edges starting above the band's bottom join the active ones; active
+    // edges that end above the band are done for every later band too.
+    // Overlapping antialiased primitives blend in drawing order, so the
+    // active lists stay sorted by index and the bins come out in the same
+    // order as a whole-image render.
+    auto admit = [](std::vector<int>& active, const std::vector<int>& order, size_t& next, auto reaches) {
+        size_t admitted = active.size();
+        while (next < order.size() && reaches(order[next])) {
+            active.push_back(order[next++]);
+        }
+        std::sort(active.begin() + admitted, active.end());
+        std::inplace_merge(active.begin(), active.begin() + admitted, active.end());
+    };
+    float reach = edgeReach();
+    float bandTop = top - reach;
+    float bandBottom = bottom + reach;
+    admit(sweep.activeEdges, sweep.edgeOrder, sweep.nextEdge, [&](int e) { return edgeTop(e) <= bandBottom; });
+
+    // Only the part of an edge inside the band (widened by the line's reach) is binned,
+    // so long edges land in the few tiles they actually cross
+    size_t kept = 0;
+    for (int e : sweep.activeEdges) {
+        float x0 = positions[2 * edges[2 * e]];
+        float y0 = positions[2 * edges[2 * e] + 1];
+        float x1 = positions[2 * edges[2 * e + 1]];
+        float y1 = positions[2 * edges[2 * e + 1] + 1];
+        if (std::max(y0, y1) < bandTop) {
+            continue;
+        }
+        sweep.activeEdges[kept++] = e;
+        if (std::max(x0, x1) + reach < 0.0f) {
+            continue;
+        }
+
+        float t0 = 0.0f;
+        float t1 = 1.0f;
+        float dy = y1 - y0;
+        if (dy != 0.0f) {
+            float enter = (bandTop - y0) / dy;
+            float leave = (bandBottom - y0) / dy;
+            t0 = std::max(t0, std::min(enter, leave));
+            t1 = std::min(t1, std::max(enter, leave));
+        }
+        float xa = x0 + (x1 - x0) * t0;
+        float xb = x0 + (x1 - x0) * t1;
+        addColumns(edgeBins, std::min(xa, xb) - reach, std::max(xa, xb) + reach, e);
+    }
+    sweep.activeEdges.resize(kept);
+
+    // Vertices the same way
+    float radius = vertexReach();
+    admit(sweep.activeVertices, sweep.vertexOrder, sweep.nextVertex,
+          [&](int v) { return positions[2 * v + 1] - radius <= bottom; });
+    kept = 0;
+    for (int v : sweep.activeVertices) {
+        float cx = positions[2 * v];
+        float cy = positions[2 * v + 1];
+        if (cy + radius < top) {
+            continue;
+        }
+        sweep.activeVertices[kept++] = v;
+        if (cx + radius >= 0.0f) {
+            addColumns(vertexBins, cx - radius, cx + radius, v);
+        }
+    }
+    sweep.activeVertices.resize(kept);
+}
+
+bool parseImageFormat(const std::string& name, ImageFormat& format) {
+    if (name == "png") {
+        format = ImageFormat::Png;
+    } else if (name == "tiff") {
+        format = ImageFormat::TiledTiff;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* imageFormatExtension(ImageFormat format) {
+    return format == ImageFormat::TiledTiff ? ".tif" : ".png";
+}
+
+void writeGraphPng(const Graph& graph, const ImageStyle& style, const std::string& path) {
+    GC_TRACE_SCOPE("write png");
+
+    GraphRaster raster(graph, style);
+    RasterImage image(0, 0, style.width, style.height);
+    raster.renderRegion(image);
+
+    if (!stbi_write_png(path.c_str(), image.getWidth(), image.getHeight(), 3, image.getPixels(),
+                        image.getWidth() * 3)) {
+        throw std::runtime_error("Cannot write image: " + path);
+    }
+}
+
+void writeGraphImage(const Graph& graph, const ImageStyle& style, ImageFormat format, const std::string& path) {
+    if (format == ImageFormat::TiledTiff) {
+        writeGraphTiff(graph, style, path);
+    } else {
+        writeGraphPng(graph, style, path);
+    }
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,235 @@
+#include "../../include/render/spatial_index.hpp"
+#include "../../include/render/quadtree.hpp"
+#include "../../include/trace/trace.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace graph_coloring {
+
+namespace {
+
+const QuadtreeLimits SPLIT_LIMITS = {8, 24};
+
+} // namespace
+
+void SpatialIndex::clear() {
+    nodes.clear();
+    positions.clear();
+    vertexOrder.clear();
+    edgeOrder.clear();
+    edgeBounds.clear();
+}
+
+void SpatialIndex::build(const Graph& graph, const std::vector<int>& edgeEndpoints) {
+    GC_TRACE_SCOPE("build spatial index");
+
+    clear();
+    const std::vector<Vertex>& vertices = graph.getVertices();
+    if (vertices.empty()) {
+        return;
+    }
+
+    Bounds bounds{vertices[0].getX(), vertices[0].getY(), vertices[0].getX(), vertices[0].getY()};
+    positions.resize(vertices.size() * 2);
+    for (size_t i = 0; i < vertices.size(); i++) {
+        float x = vertices[i].getX();
+        float y = vertices[i].getY();
+        positions[2 * i] = x;
+        positions[2 * i + 1] = y;
+        bounds.minX = std::min(bounds.minX, x);
+        bounds.minY = std::min(bounds.minY, y);
+        bounds.maxX = std::max(bounds.maxX, x);
+        bounds.maxY = std::max(bounds.maxY, y);
+    }
+
+    vertexOrder.resize(vertices.size());
+    std::iota(vertexOrder.begin(), vertexOrder.end(), 0);
+    nodes.push_back({bounds, -1, 0, static_cast<int>(vertices.size()), 0, 0});
+    split(0, 0);
+
+    // Place each edge in the deepest node containing it, then group the edges by node
+    size_t edgeCount = edgeEndpoints.size() / 2;
+    std::vector<int> edgeNodes;
+    edgeNodes.reserve(edgeCount);
+    edgeBounds.reserve(edgeCount);
+    for (size_t e = 0; e < edgeCount; e++) {
+        int source = edgeEndpoints[2 * e];
+        int target = edgeEndpoints[2 * e + 1];
+        float x0 = positions[2 * source];
+        float y0 = positions[2 * source + 1];
+        float x1 = positions[2 * target];
+        float y1 = positions[2 * target + 1];
+        Bounds box{std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1)};
+        edgeBounds.push_back(box);
+        edgeNodes.push_back(edgeNode(box));
+    }
+
+    for (int node : edgeNodes) {
+        nodes[node].edgeEnd++;
+    }
+    int offset = 0;
+    for (auto& node : nodes) {
+        node.edgeBegin = offset;
+        offset += node.edgeEnd;
+        node.edgeEnd = node.edgeBegin;
+    }
+    edgeOrder.resize(edgeNodes.size());
+    for (size_t e = 0; e < edgeNodes.size(); e++) {
+        edgeOrder[nodes[edgeNodes[e]].edgeEnd++] = static_cast<int>(e);
+    }
+}
+
+void SpatialIndex::split(int node, int depth) {
+    Node parent = nodes[node];
+    if (!SPLIT_LIMITS.splits(parent.vertexEnd - parent.vertexBegin, depth)) {
+        return;
+    }
+
+    float midX = (parent.bounds.minX + parent.bounds.maxX) * 0.5f;
+    float midY = (parent.bounds.minY + parent.bounds.maxY) * 0.5f;
+    int cuts[5];
+    partitionQuadrants(vertexOrder, parent.vertexBegin, parent.vertexEnd, midX, midY,
+                       [&](int v) { return positions[2 * v]; }, [&](int v) { return positions[2 * v + 1]; }, cuts);
+
+    int firstChild = static_cast<int>(nodes.size());
+    nodes[node].firstChild = firstChild;
+    for (int q = 0; q < 4; q++) {
+        Bounds bounds = parent.bounds;
+        (q & 1 ? bounds.minX : bounds.maxX) = midX;
+        (q & 2 ? bounds.minY : bounds.maxY) = midY;
+        nodes.push_back({bounds, -1, cuts[q], cuts[q + 1], 0, 0});
+    }
+    for (int q = 0; q < 4; q++) {
+        split(firstChild + q, depth + 1);
+    }
+}
+
+int SpatialIndex::edgeNode(const Bounds& box) const {
+    int node = 0;
+    while (nodes[node].firstChild >= 0) {
+        const Bounds& bounds = nodes[node].bounds;
+        float midX = (bounds.minX + bounds.maxX) * 0.5f;
+        float midY = (bounds.minY + bounds.maxY) * 0.5f;
+
+        // Stop at the first node where the box straddles a split line
+        int quadrant = 0;
+        if (box.minX >= midX) {
+            quadrant |= 1;
+        } else if (box.maxX >= midX) {
+            break;
+        }
+        if (box.minY >= midY) {
+            quadrant |= 2;
+        } else if (box.maxY >= midY) {
+            break;
+        }
+        node = nodes[node].firstChild + quadrant;
+    }
+    return node;
+}
+
+void SpatialIndex::queryVertices(const Bounds& area, std::vector<int>& result) const {
+    if (nodes.empty()) {
+        return;
+    }
+
+    std::vector<int> stack = {0};
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (!area.intersects(node.bounds)) {
+            continue;
+        }
+
+        if (area.contains(node.bounds)) {
+            result.insert(result.end(), vertexOrder.begin() + node.vertexBegin, vertexOrder.begin() + node.vertexEnd);
+        } else if (node.firstChild < 0) {
+            for (int i = node.vertexBegin; i < node.vertexEnd; i++) {
+                int v = vertexOrder[i];
+                if (area.contains(positions[2 * v], positions[2 * v + 1])) {
+                    result.push_back(v);
+                }
+            }
+        } else {
+            for (int q = 0; q < 4; q++) {
+                stack.push_back(node.firstChild + q);
+            }
+        }
+    }
+}
+
+void SpatialIndex::queryEdges(const Bounds& area, std::vector<int>& result) const {
+    if (nodes.empty()) {
+        return;
+    }
+
+    // A node's edges lie inside its bounds, so subtrees outside the area are skipped whole
+    std::vector<int> stack = {0};
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (!area.intersects(node.bounds)) {
+            continue;
+        }
+
+        if (area.contains(node.bounds)) {
+            result.insert(result.end(), edgeOrder.begin() + node.edgeBegin, edgeOrder.begin() + node.edgeEnd);
+        } else {
+            for (int i = node.edgeBegin; i < node.edgeEnd; i++) {
+                if (area.intersects(edgeBounds[edgeOrder[i]])) {
+                    result.push_back(edgeOrder[i]);
+                }
+            }
+        }
+        if (node.firstChild >= 0) {
+            for (int q = 0; q < 4; q++) {
+                stack.push_back(node.firstChild + q);
+            }
+        }
+    }
+}
+
+int SpatialIndex::nearestVertex(float x, float y, float maxDistance) const {
+    if (nodes.empty()) {
+        return -1;
+    }
+
+    int best = -1;
+    float bestDistance = maxDistance * maxDistance;
+
+    // Depth first, nearest child first, skipping nodes farther than the best match so far
+    std::vector<int> stack = {0};
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (node.bounds.distanceSquared(x, y) > bestDistance) {
+            continue;
+        }
+
+        if (node.firstChild < 0) {
+            for (int i = node.vertexBegin; i < node.vertexEnd; i++) {
+                int v = vertexOrder[i];
+                float dx = positions[2 * v] - x;
+                float dy = positions[2 * v + 1] - y;
+                float distance = dx * dx + dy * dy;
+                if (distance <= bestDistance) {
+                    best = v;
+                    bestDistance = distance;
+                }
+            }
+            continue;
+        }
+
+        int children[4];
+        for (int q = 0; q < 4; q++) {
+            children[q] = node.firstChild + q;
+        }
+        std::sort(children, children + 4, [&](int a, int b) {
+            return nodes[a].bounds.distanceSquared(x, y) > nodes[b].bounds.distanceSquared(x, y);
+        });
+        stack.insert(stack.end(), children, children + 4);
+    }
+    return best;
+}
+
+} // namespace graph_coloring
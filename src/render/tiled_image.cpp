@@ -0,0 +1,209 @@
+#include "../../include/render/tiled_image.hpp"
+#include "../../include/parallel/thread_pool.hpp"
+#include "../../include/trace/trace.hpp"
+#include <stdexcept>
+
+namespace graph_coloring {
+
+namespace {
+
+// TIFF field types
+const uint16_t TIFF_SHORT = 3;
+const uint16_t TIFF_LONG = 4;
+const uint16_t TIFF_LONG8 = 16;
+
+void appendLittleEndian(std::vector<uint8_t>& bytes, uint64_t value, int size) {
+    for (int i = 0; i < size; i++) {
+        bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+// Image directory under construction: entries in tag order, values that
+// don't fit in an entry go to a data block right after the directory
+class TiffDirectory {
+private:
+    bool bigTiff;
+    uint64_t offset;    // Where the directory will be written
+    int entryCount;
+    std::vector<uint8_t> entries;
+    std::vector<uint8_t> data;
+
+    int valueSize() const { return bigTiff ? 8 : 4; }
+
+    uint64_t dataOffset() const {
+        return offset + (bigTiff ? 8 : 2) + entryCount * (bigTiff ? 20 : 12) + valueSize();
+    }
+
+public:
+    TiffDirectory(bool bigTiff, uint64_t offset, int entryCount)
+        : bigTiff(bigTiff), offset(offset), entryCount(entryCount) {}
+
+    void add(uint16_t tag, uint16_t type, const std::vector<uint64_t>& values) {
+        int typeSize = type == TIFF_SHORT ? 2 : (type == TIFF_LONG ? 4 : 8);
+        std::vector<uint8_t> value;
+        for (uint64_t v : values) {
+            appendLittleEndian(value, v, typeSize);
+        }
+
+        appendLittleEndian(entries, tag, 2);
+        appendLittleEndian(entries, type, 2);
+        appendLittleEndian(entries, values.size(), valueSize());
+        if (value.size() <= static_cast<size_t>(valueSize())) {
+            value.resize(valueSize(), 0);
+            entries.insert(entries.end(), value.begin(), value.end());
+        } else {
+            appendLittleEndian(entries, dataOffset() + data.size(), valueSize());
+            data.insert(data.end(), value.begin(), value.end());
+            if (data.size() % 2) {
+                data.push_back(0); // Values start on word boundaries
+            }
+        }
+    }
+
+    std::vector<uint8_t> bytes() const {
+        std::vector<uint8_t> result;
+        appendLittleEndian(result, entryCount, bigTiff ? 8 : 2);
+        result.insert(result.end(), entries.begin(), entries.end());
+        appendLittleEndian(result, 0, valueSize()); // No further directories
+        result.insert(result.end(), data.begin(), data.end());
+        return result;
+    }
+};
+
+} // namespace
+
+TiledTiffWriter::TiledTiffWriter(const std::string& path, int width, int height, int tileSize)
+    : path(path), width(width), height(height), tileSize(tileSize), position(0) {
+    if (width <= 0 || height <= 0) {
+        throw std::runtime_error("Image size must be positive");
+    }
+    if (tileSize <= 0 || tileSize % 16 != 0) {
+        throw std::runtime_error("TIFF tile size must be a positive multiple of 16");
+    }
+    columns = (width + tileSize - 1) / tileSize;
+    rows = (height + tileSize - 1) / tileSize;
+    tileOffsets.assign(static_cast<size_t>(columns) * rows, 0);
+
+    // Pixel data plus offset tables; everything must be addressable with 32-bit offsets in a classic TIFF
+    uint64_t tileBytes = static_cast<uint64_t>(tileSize) * tileSize * 3;
+    uint64_t estimatedSize = 4096 + tileOffsets.size() * (tileBytes + 16);
+    bigTiff = estimatedSize > 0xFFFFFFFFULL;
+
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot write image: " + path);
+    }
+
+    // Header; the directory offset is filled in by finish()
+    std::vector<uint8_t> header = {'I', 'I'};
+    if (bigTiff) {
+        appendLittleEndian(header, 43, 2);
+        appendLittleEndian(header, 8, 2);
+        appendLittleEndian(header, 0, 2);
+        appendLittleEndian(header, 0, 8);
+    } else {
+        appendLittleEndian(header, 42, 2);
+        appendLittleEndian(header, 0, 4);
+    }
+    writeBytes(header.data(), header.size());
+}
+
+void TiledTiffWriter::writeBytes(const void* data, size_t size) {
+    if (!out.write(static_cast<const char*>(data), size)) {
+        throw std::runtime_error("Cannot write image: " + path);
+    }
+    position += size;
+}
+
+void TiledTiffWriter::writeTile(int column, int row, const RasterImage& tile) {
+    if (column < 0 || column >= columns || row < 0 || row >= rows) {
+        throw std::runtime_error("Tile outside the image");
+    }
+    if (tile.getWidth() != tileSize || tile.getHeight() != tileSize) {
+        throw std::runtime_error("Tile has the wrong size");
+    }
+
+    size_t index = static_cast<size_t>(row) * columns + column;
+    if (tileOffsets[index] != 0) {
+        throw std::runtime_error("Tile written twice");
+    }
+    tileOffsets[index] = position;
+    writeBytes(tile.getPixels(), static_cast<size_t>(tileSize) * tileSize * 3);
+}
+
+void TiledTiffWriter::finish() {
+    GC_TRACE_SCOPE("write tiff directory");
+
+    for (uint64_t offset : tileOffsets) {
+        if (offset == 0) {
+            throw std::runtime_error("Missing tiles in " + path);
+        }
+    }
+
+    uint64_t directoryOffset = position;
+    uint16_t offsetType = bigTiff ? TIFF_LONG8 : TIFF_LONG;
+    std::vector<uint64_t> byteCounts(tileOffsets.size(), static_cast<uint64_t>(tileSize) * tileSize * 3);
+
+    TiffDirectory directory(bigTiff, directoryOffset, 11);
+    directory.add(256, TIFF_LONG, {static_cast<uint64_t>(width)});   // ImageWidth
+    directory.add(257, TIFF_LONG, {static_cast<uint64_t>(height)});  // ImageLength
+    directory.add(258, TIFF_SHORT, {8, 8, 8});                       // BitsPerSample
+    directory.add(259, TIFF_SHORT, {1});                             // Compression: none
+    directory.add(262, TIFF_SHORT, {2});                             // Photometric: RGB
+    directory.add(277, TIFF_SHORT, {3});                             // SamplesPerPixel
+    directory.add(284, TIFF_SHORT, {1});                             // PlanarConfiguration: interleaved
+    directory.add(322, TIFF_LONG, {static_cast<uint64_t>(tileSize)}); // TileWidth
+    directory.add(323, TIFF_LONG, {static_cast<uint64_t>(tileSize)}); // TileLength
+    directory.add(324, offsetType, tileOffsets);                     // TileOffsets
+    directory.add(325, offsetType, byteCounts);                      // TileByteCounts
+
+    std::vector<uint8_t> bytes = directory.bytes();
+    writeBytes(bytes.data(), bytes.size());
+
+    std::vector<uint8_t> pointer;
+    appendLittleEndian(pointer, directoryOffset, bigTiff ? 8 : 4);
+    out.seekp(bigTiff ? 8 : 4);
+    out.write(reinterpret_cast<const char*>(pointer.data()), pointer.size());
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Cannot write image: " + path);
+    }
+}
+
+void writeGraphTiff(const Graph& graph, const ImageStyle& style, const std::string& path, int tileSize) {
+    GC_TRACE_SCOPE("write tiff");
+
+    GraphRaster raster(graph, style);
+    TiledTiffWriter writer(path, style.width, style.height, tileSize);
+
+    // One row of tiles at a time: bin the primitives that reach it, render its
+    // tiles in parallel, then append them to the file in order
+    GraphRaster::BandSweep sweep = raster.startSweep();
+    std::vector<std::vector<int>> edgeBins;
+    std::vector<std::vector<int>> vertexBins;
+    for (int row = 0; row < writer.getRows(); row++) {
+        int top = row * tileSize;
+        raster.binBand(top, top + tileSize, tileSize, sweep, edgeBins, vertexBins);
+
+        std::vector<RasterImage> band;
+        band.reserve(writer.getColumns());
+        for (int column = 0; column < writer.getColumns(); column++) {
+            band.emplace_back(column * tileSize, top, tileSize, tileSize);
+        }
+
+        parallelFor(0, band.size(), 1, [&](size_t first, size_t last) {
+            for (size_t column = first; column < last; column++) {
+                GC_TRACE_SCOPE("render tile");
+                raster.renderRegion(band[column], edgeBins[column], vertexBins[column]);
+            }
+        });
+
+        for (int column = 0; column < writer.getColumns(); column++) {
+            writer.writeTile(column, row, band[column]);
+        }
+    }
+
+    writer.finish();
+}
+
+} // namespace graph_coloring
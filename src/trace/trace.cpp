@@ -0,0 +1,172 @@
+#include "../../include/trace/trace.hpp"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace graph_coloring {
+
+std::atomic<bool> Tracer::enabled(false);
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    uint64_t startNs;
+    uint64_t endNs;
+};
+
+// Written only by its owning thread; the registry keeps it alive after the thread exits
+struct ThreadBuffer {
+    int threadId;
+    std::string threadName;
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> written; // Total events ever recorded; slot = written % capacity
+    
+    explicit ThreadBuffer(int threadId)
+        : threadId(threadId), events(Tracer::BUFFER_CAPACITY), written(0) {
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Registers the calling thread's buffer on first use
+ThreadBuffer& threadBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = []() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto created = std::make_shared<ThreadBuffer>(static_cast<int>(reg.buffers.size()));
+        reg.buffers.push_back(created);
+        return created;
+    }();
+    return *buffer;
+}
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+bool Tracer::isCompiledIn() {
+#ifdef GRAPHCOLORING_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Tracer::setEnabled(bool enable) {
+    // Touch the registry so the epoch is set before the first event
+    registry();
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.threadName = name;
+}
+
+uint64_t Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - registry().epoch).count();
+}
+
+void Tracer::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& buffer = threadBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % BUFFER_CAPACITY] = TraceEvent{name, startNs, endNs};
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+bool Tracer::writeChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    
+    // Microsecond timestamps with nanosecond precision
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    bool first = true;
+    for (const auto& buffer : reg.buffers) {
+        if (!buffer->threadName.empty()) {
+            out << (first ? "" : ",\n") << "{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": 1, \"tid\": "
+                << buffer->threadId << ", \"args\": {\"name\": ";
+            writeJsonString(out, buffer->threadName);
+            out << "}}";
+            first = false;
+        }
+        
+        // Only the most recent BUFFER_CAPACITY events survive
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t begin = written > BUFFER_CAPACITY ? written - BUFFER_CAPACITY : 0;
+        for (uint64_t i = begin; i < written; i++) {
+            const TraceEvent& event = buffer->events[i % BUFFER_CAPACITY];
+            out << (first ? "" : ",\n") << "{\"ph\": \"X\", \"name\": ";
+            writeJsonString(out, event.name);
+            out << ", \"pid\": 1, \"tid\": " << buffer->threadId
+                << ", \"ts\": " << event.startNs / 1000.0
+                << ", \"dur\": " << (event.endNs - event.startNs) / 1000.0 << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    
+    return static_cast<bool>(out);
+}
+
+void Tracer::clear() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        buffer->written.store(0, std::memory_order_release);
+    }
+}
+
+void startTracing(const std::string& tracePath) {
+    if (tracePath.empty()) {
+        return;
+    }
+    if (!Tracer::isCompiledIn()) {
+        std::cerr << "Tracing is not compiled in; rebuild with -DGRAPHCOLORING_ENABLE_TRACING=ON" << std::endl;
+        return;
+    }
+    Tracer::setThreadName("main");
+    Tracer::setEnabled(true);
+}
+
+void finishTracing(const std::string& tracePath) {
+    if (tracePath.empty() || !Tracer::isEnabled()) {
+        return;
+    }
+    Tracer::setEnabled(false);
+    if (!Tracer::writeChromeTrace(tracePath)) {
+        std::cerr << "Cannot write trace: " << tracePath << std::endl;
+    }
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,131 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/coloring/checkpoint.hpp"
+#include "../include/generators/generators.hpp"
+#include "test_util.hpp"
+
+using namespace graph_coloring;
+
+// Checkpoint files: round trip, and rejection of files that don't belong to the run
+
+namespace {
+
+SearchCheckpoint sampleCheckpoint() {
+    std::mt19937 rng(42);
+    rng.discard(1000);
+    std::ostringstream rngState;
+    rngState << rng;
+
+    SearchCheckpoint checkpoint;
+    checkpoint.algorithm = "portfolio";
+    checkpoint.graphHash = 0x0123456789abcdefULL;
+    checkpoint.best = {0, 1, 2, 0, 1};
+    checkpoint.lowerBound = 2;
+    checkpoint.exactTarget = 2;
+    checkpoint.exactPath = {0, 1, 0};
+    checkpoint.localTarget = 2;
+    checkpoint.localColoring = {0, 1, 1, 0, 1};
+    checkpoint.localRngState = rngState.str();
+    return checkpoint;
+}
+
+void testRoundTrip() {
+    std::string path = tempPath("round_trip.ckpt");
+    SearchCheckpoint written = sampleCheckpoint();
+    writeCheckpoint(path, written);
+
+    SearchCheckpoint read;
+    CHECK(readCheckpoint(path, read));
+    CHECK(read.algorithm == written.algorithm);
+    CHECK(read.graphHash == written.graphHash);
+    CHECK(read.best == written.best);
+    CHECK(read.lowerBound == written.lowerBound);
+    CHECK(read.exactTarget == written.exactTarget);
+    CHECK(read.exactPath == written.exactPath);
+    CHECK(read.localTarget == written.localTarget);
+    CHECK(read.localColoring == written.localColoring);
+    CHECK(read.localRngState == written.localRngState);
+
+    // The restored generator continues the same sequence
+    std::mt19937 original;
+    std::mt19937 restored;
+    std::istringstream(written.localRngState) >> original;
+    std::istringstream(read.localRngState) >> restored;
+    CHECK(original() == restored());
+
+    std::filesystem::remove(path);
+}
+
+void testMissingAndCorruptFiles() {
+    std::string path = tempPath("corrupt.ckpt");
+    std::filesystem::remove(path);
+    SearchCheckpoint checkpoint;
+    CHECK(!readCheckpoint(path, checkpoint));
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a checkpoint";
+    }
+    CHECK(throws([&]() { readCheckpoint(path, checkpoint); }));
+
+    // A valid file cut short
+    writeCheckpoint(path, sampleCheckpoint());
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 6);
+    CHECK(throws([&]() { readCheckpoint(path, checkpoint); }));
+
+    std::filesystem::remove(path);
+}
+
+// A Checkpointer resumes its own file and refuses one written for another
+// graph or by another algorithm
+void testCheckpointerResume() {
+    std::string path = tempPath("resume.ckpt");
+    std::filesystem::remove(path);
+    CsrGraph petersen(GraphGenerator::petersen());
+    CsrGraph cycle(GraphGenerator::cycle(10));
+    CHECK(checkpointGraphHash(petersen) != checkpointGraphHash(cycle));
+
+    {
+        Checkpointer checkpointer(path, 60.0, petersen, "exact");
+        CHECK(!checkpointer.resume());
+        CHECK(checkpointer.getResumed() == nullptr);
+        checkpointer.updateBest({0, 1, 0, 1, 2, 1, 2, 2, 0, 0}, 3);
+        checkpointer.updateExact(2, {0, 1, 0, 1, 0, 0, 0, 0, 0, 0}, 4);
+        checkpointer.save();
+    }
+
+    {
+        Checkpointer checkpointer(path, 60.0, petersen, "exact");
+        CHECK(checkpointer.resume());
+        const SearchCheckpoint* resumed = checkpointer.getResumed();
+        CHECK(resumed != nullptr);
+        if (resumed) {
+            CHECK(resumed->lowerBound == 3);
+            CHECK(resumed->best.size() == 10);
+            CHECK(resumed->exactTarget == 2);
+            CHECK(resumed->exactPath == std::vector<int>({0, 1, 0, 1}));
+        }
+    }
+
+    Checkpointer otherGraph(path, 60.0, cycle, "exact");
+    CHECK(throws([&]() { otherGraph.resume(); }));
+    Checkpointer otherAlgorithm(path, 60.0, petersen, "portfolio");
+    CHECK(throws([&]() { otherAlgorithm.resume(); }));
+
+    Checkpointer finished(path, 60.0, petersen, "exact");
+    finished.discard();
+    CHECK(!std::filesystem::exists(path));
+}
+
+} // namespace
+
+int main() {
+    testRoundTrip();
+    testMissingAndCorruptFiles();
+    testCheckpointerResume();
+    return testResult("checkpoint_test");
+}
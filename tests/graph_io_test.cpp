@@ -0,0 +1,49 @@
+#include <sstream>
+#include <string>
+#include "../include/io/graph_io.hpp"
+#include "test_util.hpp"
+
+using namespace graph_coloring;
+
+// Graph file loaders: what they accept and what they reject
+
+namespace {
+
+Graph loadEdgeList(const std::string& text) {
+    std::istringstream input(text);
+    return GraphLoader::loadEdgeList(input);
+}
+
+Graph loadDimacs(const std::string& text) {
+    std::istringstream input(text);
+    return GraphLoader::loadDimacs(input);
+}
+
+void testEdgeList() {
+    Graph graph = loadEdgeList("# comment\n% comment\n\n   \t\n1 2\n2 3\r\n  3 1  \n4\n5 5\n");
+    CHECK(graph.getVertexCount() == 5);
+    CHECK(graph.getEdgeCount() == 3);
+
+    CHECK(throws([]() { loadEdgeList("1 2\na b\n"); }));
+    CHECK(throws([]() { loadEdgeList("1 x\n"); }));
+    CHECK(throws([]() { loadEdgeList("1 2 3\n"); }));
+    CHECK(throws([]() { loadEdgeList("1 2x\n"); }));
+}
+
+void testDimacs() {
+    Graph graph = loadDimacs("c comment\np edge 3 2\n   \ne 1 2\ne 2 3\n");
+    CHECK(graph.getVertexCount() == 3);
+    CHECK(graph.getEdgeCount() == 2);
+
+    CHECK(throws([]() { loadDimacs("e 1 2\n"); }));
+    CHECK(throws([]() { loadDimacs("p edge 3 1\ne 1\n"); }));
+    CHECK(throws([]() { loadDimacs("c no problem line\n"); }));
+}
+
+} // namespace
+
+int main() {
+    testEdgeList();
+    testDimacs();
+    return testResult("graph_io_test");
+}
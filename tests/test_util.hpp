@@ -0,0 +1,51 @@
+#pragma once
+
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace graph_coloring {
+
+// Minimal checks shared by the test executables: a failed CHECK is reported
+// and counted, and main returns testResult() so CTest sees the failure
+
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void checkFailed(const char* condition, const char* file, int line) {
+    std::cerr << file << ":" << line << ": CHECK(" << condition << ") failed" << std::endl;
+    testFailures()++;
+}
+
+#define CHECK(condition) \
+    ((condition) ? (void)0 : ::graph_coloring::checkFailed(#condition, __FILE__, __LINE__))
+
+// True if body throws a std::exception
+template <typename Body>
+bool throws(Body body) {
+    try {
+        body();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+// Path of a scratch file in the system temp directory
+inline std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("graphcoloring_" + name)).string();
+}
+
+inline int testResult(const std::string& name) {
+    if (testFailures() > 0) {
+        std::cerr << name << ": " << testFailures() << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << name << ": ok" << std::endl;
+    return 0;
+}
+
+} // namespace graph_coloring
@@ -0,0 +1,205 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../include/parallel/thread_pool.hpp"
+#include "../include/parallel/work_stealing_deque.hpp"
+#include "test_util.hpp"
+
+using namespace graph_coloring;
+
+// Stress tests for the work-stealing deque, task groups and parallelFor
+
+namespace {
+
+// Depth of TaskGroup::wait() calls made from inside an outer task on this thread
+thread_local int innerWaitDepth = 0;
+
+// The owner pushes and pops while thieves steal; every item must be taken
+// exactly once. A small initial capacity makes the buffer grow under steals.
+void testDequeSteals() {
+    const int itemCount = 200000;
+    const int thiefCount = 3;
+    WorkStealingDeque<int> deque(4);
+    std::vector<std::atomic<int>> taken(itemCount);
+    std::atomic<bool> ownerDone(false);
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < thiefCount; t++) {
+        thieves.emplace_back([&]() {
+            int item;
+            while (!ownerDone.load() || !deque.empty()) {
+                if (deque.steal(item)) {
+                    taken[item]++;
+                }
+            }
+        });
+    }
+
+    int item;
+    for (int i = 0; i < itemCount; i++) {
+        deque.push(i);
+        // Pop every third item back, racing the thieves for the last ones
+        if (i % 3 == 2 && deque.pop(item)) {
+            taken[item]++;
+        }
+    }
+    while (deque.pop(item)) {
+        taken[item]++;
+    }
+    ownerDone.store(true);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    int wrong = 0;
+    for (int i = 0; i < itemCount; i++) {
+        wrong += taken[i].load() != 1;
+    }
+    CHECK(wrong == 0);
+}
+
+void testGroupRunsEveryTask() {
+    ThreadPool pool(4);
+    std::atomic<int> count(0);
+    TaskGroup group(pool);
+    for (int i = 0; i < 10000; i++) {
+        group.run([&count]() { count++; });
+    }
+    group.wait();
+    CHECK(count.load() == 10000);
+}
+
+// Outer tasks wait on inner groups from pool workers. The waits must finish
+// (no deadlock) and must only help with their own inner tasks, never start
+// another outer task on top of the waiting one.
+void testNestedWait() {
+    ThreadPool pool(4);
+    std::atomic<int> inner(0);
+    std::atomic<int> nestedOuter(0);
+    TaskGroup outer(pool);
+    for (int i = 0; i < 64; i++) {
+        outer.run([&]() {
+            if (innerWaitDepth > 0) {
+                nestedOuter++;
+            }
+            TaskGroup group(pool);
+            for (int j = 0; j < 64; j++) {
+                group.run([&inner]() { inner++; });
+            }
+            innerWaitDepth++;
+            group.wait();
+            innerWaitDepth--;
+        });
+    }
+    outer.wait();
+    CHECK(inner.load() == 64 * 64);
+    CHECK(nestedOuter.load() == 0);
+}
+
+// A wait from the only worker must reach its group's task even when a task
+// of no group was pushed on top of it. Nothing else can run the task, so a
+// broken wait spins forever; the test gives up after a timeout instead.
+void testWaitReachesBuriedTask() {
+    ThreadPool pool(1);
+    std::atomic<bool> ranOwn(false);
+    std::atomic<bool> ranOther(false);
+    std::atomic<bool> finished(false);
+    pool.submit([&]() {
+        TaskGroup group(pool);
+        group.run([&ranOwn]() { ranOwn.store(true); });
+        pool.submit([&ranOther]() { ranOther.store(true); });
+        group.wait();
+        finished.store(true);
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!(finished.load() && ranOther.load()) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    CHECK(finished.load());
+    CHECK(ranOwn.load());
+    CHECK(ranOther.load());
+    if (!finished.load()) {
+        // The stuck worker would block the pool's destructor
+        std::exit(testResult("thread_pool_test"));
+    }
+}
+
+// Tasks of a cancelled group that have not started are skipped
+void testCancellation() {
+    ThreadPool pool(1);
+    std::atomic<bool> started(false);
+    std::atomic<bool> release(false);
+    TaskGroup blocker(pool);
+    blocker.run([&]() {
+        started.store(true);
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+
+    std::atomic<int> ran(0);
+    TaskGroup group(pool);
+    for (int i = 0; i < 100; i++) {
+        group.run([&ran]() { ran++; });
+    }
+    group.cancel();
+    release.store(true);
+    group.wait();
+    blocker.wait();
+    CHECK(group.isCancelled());
+    CHECK(ran.load() == 0);
+}
+
+void testExceptionPropagates() {
+    ThreadPool pool(2);
+    TaskGroup group(pool);
+    for (int i = 0; i < 10; i++) {
+        group.run([i]() {
+            if (i == 5) {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+    CHECK(throws([&group]() { group.wait(); }));
+    // The error is reported once
+    group.wait();
+}
+
+void testParallelFor() {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(100000);
+    parallelFor(0, visits.size(), 100, [&](size_t first, size_t last) {
+        CHECK(last - first <= 100);
+        for (size_t i = first; i < last; i++) {
+            visits[i]++;
+        }
+    }, pool);
+
+    int wrong = 0;
+    for (auto& visit : visits) {
+        wrong += visit.load() != 1;
+    }
+    CHECK(wrong == 0);
+}
+
+} // namespace
+
+int main() {
+    for (int round = 0; round < 5; round++) {
+        testDequeSteals();
+        testNestedWait();
+    }
+    testGroupRunsEveryTask();
+    testWaitReachesBuriedTask();
+    testCancellation();
+    testExceptionPropagates();
+    testParallelFor();
+    return testResult("thread_pool_test");
+}
@@ -0,0 +1,147 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+#include "../include/generators/generators.hpp"
+#include "../include/render/tiled_image.hpp"
+#include "test_util.hpp"
+
+using namespace graph_coloring;
+
+// Tiled TIFF output: header, image directory and tile data of small images
+
+namespace {
+
+std::vector<uint8_t> readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+uint64_t readLittleEndian(const std::vector<uint8_t>& bytes, uint64_t offset, int size) {
+    uint64_t value = 0;
+    for (int i = 0; i < size && offset + i < bytes.size(); i++) {
+        value |= static_cast<uint64_t>(bytes[offset + i]) << (8 * i);
+    }
+    return value;
+}
+
+// Values of every entry of a classic TIFF's first directory, by tag
+std::map<uint16_t, std::vector<uint64_t>> readDirectory(const std::vector<uint8_t>& file) {
+    std::map<uint16_t, std::vector<uint64_t>> tags;
+    uint64_t offset = readLittleEndian(file, 4, 4);
+    int entryCount = static_cast<int>(readLittleEndian(file, offset, 2));
+    uint16_t previousTag = 0;
+    for (int e = 0; e < entryCount; e++) {
+        uint64_t entry = offset + 2 + e * 12;
+        uint16_t tag = static_cast<uint16_t>(readLittleEndian(file, entry, 2));
+        uint16_t type = static_cast<uint16_t>(readLittleEndian(file, entry + 2, 2));
+        uint64_t count = readLittleEndian(file, entry + 4, 4);
+        CHECK(tag > previousTag); // Entries must be sorted by tag
+        previousTag = tag;
+
+        int typeSize = type == 3 ? 2 : 4; // SHORT or LONG
+        uint64_t valueOffset = count * typeSize <= 4 ? entry + 8 : readLittleEndian(file, entry + 8, 4);
+        for (uint64_t i = 0; i < count; i++) {
+            tags[tag].push_back(readLittleEndian(file, valueOffset + i * typeSize, typeSize));
+        }
+    }
+    CHECK(readLittleEndian(file, offset + 2 + entryCount * 12, 4) == 0); // No further directories
+    return tags;
+}
+
+// A 40x20 image in 16-pixel tiles: 3 columns and 2 rows, each tile filled
+// with its own color and written out of order
+void testTinyImage() {
+    std::string path = tempPath("tiny.tif");
+    const int tileSize = 16;
+    {
+        TiledTiffWriter writer(path, 40, 20, tileSize);
+        CHECK(writer.getColumns() == 3);
+        CHECK(writer.getRows() == 2);
+        CHECK(!writer.isBigTiff());
+        for (int index = 5; index >= 0; index--) {
+            RasterImage tile(0, 0, tileSize, tileSize);
+            unsigned char rgb[3] = {static_cast<unsigned char>(index), 100, 200};
+            tile.fill(rgb);
+            writer.writeTile(index % 3, index / 3, tile);
+        }
+        writer.finish();
+    }
+
+    std::vector<uint8_t> file = readFile(path);
+    CHECK(file.size() > 8);
+    CHECK(file[0] == 'I' && file[1] == 'I');
+    CHECK(readLittleEndian(file, 2, 2) == 42);
+
+    std::map<uint16_t, std::vector<uint64_t>> tags = readDirectory(file);
+    CHECK(tags[256] == std::vector<uint64_t>({40}));      // ImageWidth
+    CHECK(tags[257] == std::vector<uint64_t>({20}));      // ImageLength
+    CHECK(tags[258] == std::vector<uint64_t>({8, 8, 8})); // BitsPerSample
+    CHECK(tags[259] == std::vector<uint64_t>({1}));       // Compression: none
+    CHECK(tags[262] == std::vector<uint64_t>({2}));       // Photometric: RGB
+    CHECK(tags[277] == std::vector<uint64_t>({3}));       // SamplesPerPixel
+    CHECK(tags[284] == std::vector<uint64_t>({1}));       // PlanarConfiguration
+    CHECK(tags[322] == std::vector<uint64_t>({16}));      // TileWidth
+    CHECK(tags[323] == std::vector<uint64_t>({16}));      // TileLength
+    CHECK(tags[324].size() == 6);                         // TileOffsets
+    CHECK(tags[325] == std::vector<uint64_t>(6, tileSize * tileSize * 3)); // TileByteCounts
+
+    // Tile offsets are in row-major tile order, whatever order they were written in
+    for (size_t index = 0; index < tags[324].size(); index++) {
+        uint64_t offset = tags[324][index];
+        CHECK(offset + tileSize * tileSize * 3 <= file.size());
+        if (offset + 3 <= file.size()) {
+            CHECK(file[offset] == index && file[offset + 1] == 100 && file[offset + 2] == 200);
+        }
+    }
+
+    std::filesystem::remove(path);
+}
+
+void testWriterErrors() {
+    std::string path = tempPath("errors.tif");
+    CHECK(throws([&]() { TiledTiffWriter writer(path, 40, 20, 20); }));
+    CHECK(throws([&]() { TiledTiffWriter writer(path, 0, 20, 16); }));
+    CHECK(throws([]() { RasterImage image(0, 0, -70000, -70000); }));
+
+    TiledTiffWriter writer(path, 40, 20, 16);
+    RasterImage tile(0, 0, 16, 16);
+    RasterImage wrongSize(0, 0, 8, 8);
+    CHECK(throws([&]() { writer.writeTile(3, 0, tile); }));
+    CHECK(throws([&]() { writer.writeTile(0, 0, wrongSize); }));
+    writer.writeTile(0, 0, tile);
+    CHECK(throws([&]() { writer.writeTile(0, 0, tile); }));
+    CHECK(throws([&]() { writer.finish(); })); // Five tiles missing
+
+    std::filesystem::remove(path);
+}
+
+// The full pipeline on a small graph produces a readable directory
+void testGraphTiff() {
+    std::string path = tempPath("petersen.tif");
+    Graph graph = GraphGenerator::petersen();
+    ImageStyle style;
+    style.width = 100;
+    style.height = 70;
+    writeGraphTiff(graph, style, path, 32);
+
+    std::vector<uint8_t> file = readFile(path);
+    std::map<uint16_t, std::vector<uint64_t>> tags = readDirectory(file);
+    CHECK(tags[256] == std::vector<uint64_t>({100}));
+    CHECK(tags[257] == std::vector<uint64_t>({70}));
+    CHECK(tags[324].size() == 4 * 3);
+
+    std::filesystem::remove(path);
+}
+
+} // namespace
+
+int main() {
+    testTinyImage();
+    testWriterErrors();
+    testGraphTiff();
+    return testResult("tiled_tiff_test");
+}